@@ -0,0 +1,96 @@
+/*
+ * BITBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/ure/backwardchainer/BIT.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Expand from a random leaf with the deduction rule, the leaf is
+// returned alongside the rule unified with it.
+static std::pair<Handle, RuleTypedSubstitutionPair>
+select_expansion(AndBIT& andbit, const Rule& rule)
+{
+	Handle leaf = andbit.select_leaf()->body;
+	return {leaf, *rule.unify_target(leaf).begin()};
+}
+
+// Expand an and-BIT that has already been expanded a number of
+// times. The size is the number of prior expansions.
+static void BM_AndBIT_expand(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	Handle rbs = as.add_node(CONCEPT_NODE, "bench-rbs");
+	Rule rule(add_deduction_rule(as, rbs), rbs);
+	Handle target = as.add_link(INHERITANCE_LINK,
+	                            add_concept(as, "C", 0),
+	                            add_concept(as, "C", 1));
+	AndBIT andbit(as, target, Handle::UNDEFINED);
+	for (long i = 0; i < state.range(0); i++) {
+		auto expansion = select_expansion(andbit, rule);
+		AndBIT expanded = andbit.expand(expansion.first, expansion.second);
+		if (expanded.fcs)
+			andbit = expanded;
+	}
+	auto expansion = select_expansion(andbit, rule);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(andbit.expand(expansion.first,
+		                                       expansion.second));
+	state.SetComplexityN(state.range(0) + 1);
+}
+BENCHMARK(BM_AndBIT_expand)->DenseRange(0, 12, 4)->Complexity();
+
+// Insert and-BITs into an empty BIT. The size is the number of
+// and-BITs.
+static void BM_BIT_insert(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	HandleSeq targets;
+	for (long i = 0; i < state.range(0); i++)
+		targets.push_back(as.add_link(INHERITANCE_LINK,
+		                              add_concept(as, "C", i),
+		                              as.add_node(VARIABLE_NODE, "$T")));
+
+	// The BIT of the previous iteration is destroyed while timing is
+	// paused.
+	std::unique_ptr<BIT> bit;
+	for (auto _ : state) {
+		state.PauseTiming();
+		bit.reset(new BIT());
+		std::vector<AndBIT> andbits;
+		for (const Handle& target : targets)
+			andbits.emplace_back(bit->bit_as, target, Handle::UNDEFINED);
+		state.ResumeTiming();
+		for (AndBIT& andbit : andbits)
+			bit->insert(andbit);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BIT_insert)->RangeMultiplier(4)->Range(4, 1024)->Complexity();
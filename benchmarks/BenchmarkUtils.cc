@@ -0,0 +1,136 @@
+/*
+ * BenchmarkUtils.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <fstream>
+#include <string>
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/mt19937ar.h>
+#include <opencog/atoms/truthvalue/TruthValue.h>
+#include <opencog/ure/URELogger.h>
+
+#include "BenchmarkUtils.h"
+
+namespace opencog
+{
+
+Handle add_deduction_rule(AtomSpace& as, const Handle& rbs, size_t premises)
+{
+	// Variables X0 to Xn, typed as concepts
+	Handle concept_t = as.add_node(TYPE_NODE, "ConceptNode");
+	HandleSeq vars, typed_vars;
+	for (size_t i = 0; i <= premises; i++) {
+		Handle var = as.add_node(VARIABLE_NODE, "$X" + std::to_string(i));
+		vars.push_back(var);
+		typed_vars.push_back(as.add_link(TYPED_VARIABLE_LINK, var, concept_t));
+	}
+	Handle vardecl = as.add_link(VARIABLE_SET, std::move(typed_vars));
+
+	// Premises, Xi->Xi+1, and conclusion, X0->Xn
+	HandleSeq clauses;
+	for (size_t i = 0; i < premises; i++)
+		clauses.push_back(as.add_link(INHERITANCE_LINK, vars[i], vars[i + 1]));
+	Handle conclusion = as.add_link(INHERITANCE_LINK, vars.front(), vars.back());
+
+	// Pattern
+	Handle precondition =
+		as.add_link(NOT_LINK,
+		            as.add_link(IDENTICAL_LINK, vars.front(), vars.back()));
+	Handle pattern = as.add_link(AND_LINK,
+	                             as.add_link(PRESENT_LINK, HandleSeq(clauses)),
+	                             precondition);
+
+	// Rewrite
+	HandleSeq args{conclusion};
+	args.insert(args.end(), clauses.begin(), clauses.end());
+	Handle formula = as.add_node(GROUNDED_SCHEMA_NODE, "scm: bench-deduction");
+	Handle rewrite = as.add_link(EXECUTION_OUTPUT_LINK, formula,
+	                             as.add_link(LIST_LINK, std::move(args)));
+
+	// Define it and add it to the rule base
+	Handle rule = as.add_link(BIND_LINK, vardecl, pattern, rewrite);
+	Handle alias = as.add_node(DEFINED_SCHEMA_NODE,
+	                           "bench-deduction-rule-" + std::to_string(premises));
+	as.add_link(DEFINE_LINK, alias, rule);
+	as.add_link(MEMBER_LINK, alias, rbs)->setTruthValue(TruthValue::TRUE_TV());
+	return alias;
+}
+
+Handle add_modus_ponens_rule(AtomSpace& as, const Handle& rbs)
+{
+	// Variables A and B, typed as predicates
+	Handle predicate_t = as.add_node(TYPE_NODE, "PredicateNode");
+	Handle A = as.add_node(VARIABLE_NODE, "$A"),
+		B = as.add_node(VARIABLE_NODE, "$B");
+	Handle vardecl = as.add_link(VARIABLE_SET,
+	                             as.add_link(TYPED_VARIABLE_LINK, A, predicate_t),
+	                             as.add_link(TYPED_VARIABLE_LINK, B, predicate_t));
+
+	// Pattern, no need to include A as it is already in AB
+	Handle AB = as.add_link(IMPLICATION_LINK, A, B);
+	Handle pattern = as.add_link(PRESENT_LINK, AB);
+
+	// Rewrite
+	Handle formula = as.add_node(GROUNDED_SCHEMA_NODE, "scm: bench-modus-ponens");
+	Handle rewrite = as.add_link(EXECUTION_OUTPUT_LINK, formula,
+	                             as.add_link(LIST_LINK, B, A, AB));
+
+	// Define it and add it to the rule base
+	Handle rule = as.add_link(BIND_LINK, vardecl, pattern, rewrite);
+	Handle alias = as.add_node(DEFINED_SCHEMA_NODE, "bench-modus-ponens-rule");
+	as.add_link(DEFINE_LINK, alias, rule);
+	as.add_link(MEMBER_LINK, alias, rbs)->setTruthValue(TruthValue::TRUE_TV());
+	return alias;
+}
+
+Handle add_concept(AtomSpace& as, const std::string& prefix, size_t i)
+{
+	return as.add_node(CONCEPT_NODE, prefix + std::to_string(i));
+}
+
+size_t peak_rss()
+{
+	// Linux only, VmHWM is the high water mark of the resident set
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line))
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return 1024 * std::stoul(line.substr(6));
+	return 0;
+}
+
+bool reset_peak_rss()
+{
+	// Linux only, since 4.0 writing 5 to clear_refs resets VmHWM
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5";
+	clear_refs.close();
+	return (bool)clear_refs;
+}
+
+void setup_benchmark()
+{
+	randGen().seed(0);
+	logger().set_level(Logger::ERROR);
+	ure_logger().set_level(Logger::ERROR);
+}
+
+} // ~namespace opencog
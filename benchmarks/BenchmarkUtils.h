@@ -0,0 +1,98 @@
+/*
+ * BenchmarkUtils.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_BENCHMARK_UTILS_H_
+#define _OPENCOG_URE_BENCHMARK_UTILS_H_
+
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+
+/**
+ * Add to as a crisp deduction rule over InheritanceLinks between
+ * ConceptNodes, generalized to a chain of the given number of
+ * premises
+ *
+ * Inheritance X0 X1
+ * ...
+ * Inheritance Xn-1 Xn
+ * |-
+ * Inheritance X0 Xn
+ *
+ * With 2 premises it is the rule of
+ * tests/ure/rules/bc-deduction-rule.scm, minus the scheme
+ * preconditions. The rule is defined under a DefinedSchemaNode and
+ * made member of rbs. Return its alias.
+ *
+ * The rule formula is the GroundedSchemaNode "scm: bench-deduction",
+ * which has to be defined only if the rule is actually applied.
+ */
+Handle add_deduction_rule(AtomSpace& as, const Handle& rbs,
+                          size_t premises=2);
+
+/**
+ * Add to as a crisp modus ponens rule over ImplicationLinks between
+ * PredicateNodes
+ *
+ * A
+ * Implication A B
+ * |-
+ * B
+ *
+ * like tests/ure/rules/crisp-modus-ponens-rule.scm, minus the scheme
+ * preconditions. The rule is defined under a DefinedSchemaNode and
+ * made member of rbs. Return its alias.
+ *
+ * The rule formula is the GroundedSchemaNode "scm: bench-modus-ponens",
+ * which has to be defined only if the rule is actually applied.
+ */
+Handle add_modus_ponens_rule(AtomSpace& as, const Handle& rbs);
+
+/**
+ * Return the ConceptNode named prefix followed by i.
+ */
+Handle add_concept(AtomSpace& as, const std::string& prefix, size_t i);
+
+/**
+ * Return the peak resident set size of the process in bytes, since
+ * its start or the last call of reset_peak_rss, or 0 if it cannot be
+ * determined.
+ */
+size_t peak_rss();
+
+/**
+ * Reset the peak resident set size to the current one, so that
+ * peak_rss measures a single run. Return false if it cannot be reset,
+ * then peak_rss remains the peak since the start of the process.
+ */
+bool reset_peak_rss();
+
+/**
+ * Reseed the random generator and silence the loggers so that
+ * benchmark results are reproducible and comparable across runs.
+ */
+void setup_benchmark();
+
+} // ~namespace opencog
+
+#endif // _OPENCOG_URE_BENCHMARK_UTILS_H_
@@ -0,0 +1,121 @@
+/*
+ * BetaDistributionBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/ure/BetaDistribution.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Number of points of the cdf and pdf, the default of ThompsonSampling
+static const int bins = 100;
+
+// Beta-distribution of strength 0.3 and the given count
+static BetaDistribution mk_count_beta_distribution(long count)
+{
+	return BetaDistribution(0.3 * count, count);
+}
+
+// Calculate the cdf at all points. The size is the count of the
+// distribution.
+static void BM_BetaDistribution_cdf(benchmark::State& state)
+{
+	setup_benchmark();
+	BetaDistribution bd = mk_count_beta_distribution(state.range(0));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(bd.cdf(bins));
+}
+BENCHMARK(BM_BetaDistribution_cdf)->RangeMultiplier(10)->Range(1, 1000000);
+
+// Like BM_BetaDistribution_cdf but evaluating boost::math::cdf point
+// by point, for reference.
+static void BM_BetaDistribution_cdf_boost(benchmark::State& state)
+{
+	setup_benchmark();
+	BetaDistribution bd = mk_count_beta_distribution(state.range(0));
+	boost::math::beta_distribution<double> ref(bd.alpha(), bd.beta());
+
+	for (auto _ : state) {
+		std::vector<double> cdf;
+		for (int x_idx = 0; x_idx < bins; x_idx++)
+			cdf.push_back(boost::math::cdf(ref, std::min(1.0, (x_idx + 1.0) / bins)));
+		benchmark::DoNotOptimize(cdf);
+	}
+}
+BENCHMARK(BM_BetaDistribution_cdf_boost)->RangeMultiplier(10)->Range(1, 1000000);
+
+// Calculate the pdf at all points. The size is the count of the
+// distribution.
+static void BM_BetaDistribution_pdf(benchmark::State& state)
+{
+	setup_benchmark();
+	BetaDistribution bd = mk_count_beta_distribution(state.range(0));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(bd.pdf(bins));
+}
+BENCHMARK(BM_BetaDistribution_pdf)->RangeMultiplier(10)->Range(1, 1000000);
+
+static void BM_BetaDistribution_pdf_boost(benchmark::State& state)
+{
+	setup_benchmark();
+	BetaDistribution bd = mk_count_beta_distribution(state.range(0));
+	boost::math::beta_distribution<double> ref(bd.alpha(), bd.beta());
+
+	for (auto _ : state) {
+		std::vector<double> pdf;
+		for (int x_idx = 0; x_idx < bins; x_idx++)
+			pdf.push_back(boost::math::pdf(ref, std::min(1.0, (x_idx + 1.0) / bins)));
+		benchmark::DoNotOptimize(pdf);
+	}
+}
+BENCHMARK(BM_BetaDistribution_pdf_boost)->RangeMultiplier(10)->Range(1, 1000000);
+
+// Build a TV with mk_stv, with an empty memo, for reference.
+static void BM_mk_stv_miss(benchmark::State& state)
+{
+	setup_benchmark();
+	BetaDistribution bd = mk_count_beta_distribution(100);
+
+	for (auto _ : state) {
+		clear_beta_distribution_memos();
+		benchmark::DoNotOptimize(mk_stv(bd.mean(), bd.variance()));
+	}
+}
+BENCHMARK(BM_mk_stv_miss);
+
+// Build a TV with mk_stv, hitting the memo.
+static void BM_mk_stv_hit(benchmark::State& state)
+{
+	setup_benchmark();
+	BetaDistribution bd = mk_count_beta_distribution(100);
+	clear_beta_distribution_memos();
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(mk_stv(bd.mean(), bd.variance()));
+}
+BENCHMARK(BM_mk_stv_hit);
@@ -0,0 +1,186 @@
+/*
+ * ChainerBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/ure/UREConfig.h>
+#include <opencog/ure/forwardchainer/ForwardChainer.h>
+#include <opencog/ure/backwardchainer/BackwardChainer.h>
+
+#include "BenchmarkUtils.h"
+#include "KBGenerator.h"
+
+using namespace opencog;
+
+// Maximum number of iterations of each chainer run
+static const int max_iter = 100;
+
+// Define the formulas of the rules generated by KBGenerator
+static void define_formulas(AtomSpace& as)
+{
+	SchemeEval eval(&as);
+	eval.eval("(use-modules (opencog))");
+	eval.eval("(define (bench-deduction AC . premises)"
+	          "  (cog-set-tv! AC (stv 1 1)))");
+	eval.eval("(define (bench-modus-ponens B A AB)"
+	          "  (if (< 0.5 (cog-mean A)) (cog-set-tv! B (stv 1 1)) B))");
+}
+
+// Set the counters common to all chainer benchmarks. The peak memory
+// is only reported if it has been reset at the start of the run,
+// otherwise it would be the one of the largest previous run.
+static void set_counters(benchmark::State& state,
+                         size_t iterations, size_t results,
+                         bool peak_rss_reset)
+{
+	state.counters["iterations/s"] =
+		benchmark::Counter(iterations, benchmark::Counter::kIsRate);
+	state.counters["results/s"] =
+		benchmark::Counter(results, benchmark::Counter::kIsRate);
+	if (peak_rss_reset)
+		state.counters["peak_rss_MB"] = peak_rss() / (1024.0 * 1024.0);
+	state.SetComplexityN(state.range(0));
+}
+
+// Run the forward chainer from the generator source over a generated
+// knowledge base. Each run takes place in a fresh child atomspace of
+// the knowledge base, destroyed while timing is paused.
+template<typename GenerateKB, typename GenerateRBS>
+static void run_fc(benchmark::State& state,
+                   GenerateKB generate_kb, GenerateRBS generate_rbs)
+{
+	setup_benchmark();
+	bool peak_rss_reset = reset_peak_rss();
+	AtomSpace as;
+	define_formulas(as);
+	KBParameters params;
+	params.concepts = state.range(0);
+	KBGenerator generator(as, params);
+	generate_kb(generator);
+	UREConfig config(as, generate_rbs(generator));
+
+	size_t iterations = 0, results = 0;
+	std::unique_ptr<AtomSpace> kb_as;
+	for (auto _ : state) {
+		state.PauseTiming();
+		kb_as.reset(new AtomSpace(&as));
+		state.ResumeTiming();
+		ForwardChainer fc(*kb_as, config, generator.get_source());
+		fc.do_chain();
+		iterations += fc.get_iteration();
+		results += fc.get_results_set().size();
+	}
+	set_counters(state, iterations, results, peak_rss_reset);
+}
+
+// Same as above for the backward chainer, targeting target_of the
+// generator target. If focused, the first tree of the knowledge base,
+// which holds the proof of the target, is the focus set.
+template<typename GenerateKB, typename GenerateRBS, typename TargetOf>
+static void run_bc(benchmark::State& state,
+                   GenerateKB generate_kb, GenerateRBS generate_rbs,
+                   TargetOf target_of, bool focused=false)
+{
+	setup_benchmark();
+	bool peak_rss_reset = reset_peak_rss();
+	AtomSpace as;
+	define_formulas(as);
+	KBParameters params;
+	params.concepts = state.range(0);
+	KBGenerator generator(as, params);
+	generate_kb(generator);
+	UREConfig config(as, generate_rbs(generator));
+	Handle target = target_of(generator.get_target());
+	Handle focus_set = focused ?
+		as.add_link(SET_LINK, HandleSeq(generator.get_first_tree())) :
+		Handle::UNDEFINED;
+
+	size_t iterations = 0, results = 0;
+	std::unique_ptr<AtomSpace> kb_as;
+	for (auto _ : state) {
+		state.PauseTiming();
+		kb_as.reset(new AtomSpace(&as));
+		state.ResumeTiming();
+		BackwardChainer bc(*kb_as, config, target, Handle::UNDEFINED,
+		                   nullptr, nullptr, focus_set);
+		bc.do_chain();
+		iterations += bc.get_iteration();
+		results += bc.get_results_set().size();
+	}
+	set_counters(state, iterations, results, peak_rss_reset);
+}
+
+static void BM_FC_deduction(benchmark::State& state)
+{
+	run_fc(state,
+	       [](KBGenerator& gen) { return gen.inheritance_kb(); },
+	       [](KBGenerator& gen) { return gen.deduction_rule_base(max_iter); });
+}
+
+static void BM_FC_modus_ponens(benchmark::State& state)
+{
+	run_fc(state,
+	       [](KBGenerator& gen) { return gen.implication_kb(); },
+	       [](KBGenerator& gen) { return gen.modus_ponens_rule_base(max_iter); });
+}
+
+static void BM_BC_deduction(benchmark::State& state)
+{
+	run_bc(state,
+	       [](KBGenerator& gen) { return gen.inheritance_kb(); },
+	       [](KBGenerator& gen) { return gen.deduction_rule_base(max_iter); },
+	       [](const Handle& link) { return link; });
+}
+
+// Like BM_BC_deduction but focused on the first tree, to gauge the
+// speedup of the focus set as the rest of the knowledge base grows.
+static void BM_BC_deduction_focus_set(benchmark::State& state)
+{
+	run_bc(state,
+	       [](KBGenerator& gen) { return gen.inheritance_kb(); },
+	       [](KBGenerator& gen) { return gen.deduction_rule_base(max_iter); },
+	       [](const Handle& link) { return link; },
+	       true);
+}
+
+static void BM_BC_modus_ponens(benchmark::State& state)
+{
+	// Target the root predicate of the chain
+	run_bc(state,
+	       [](KBGenerator& gen) { return gen.implication_kb(); },
+	       [](KBGenerator& gen) { return gen.modus_ponens_rule_base(max_iter); },
+	       [](const Handle& link) { return link->getOutgoingAtom(1); });
+}
+
+// Knowledge bases from a thousand to a million concepts. Runs are
+// long, so they are timed in wall clock milliseconds.
+#define CHAINER_BENCHMARK(name)                                         \
+	BENCHMARK(name)->RangeMultiplier(10)->Range(1000, 1000000)          \
+	->Unit(benchmark::kMillisecond)->UseRealTime()->Complexity()
+
+CHAINER_BENCHMARK(BM_FC_deduction);
+CHAINER_BENCHMARK(BM_FC_modus_ponens);
+CHAINER_BENCHMARK(BM_BC_deduction);
+CHAINER_BENCHMARK(BM_BC_deduction_focus_set);
+CHAINER_BENCHMARK(BM_BC_modus_ponens);
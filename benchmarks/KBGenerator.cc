@@ -0,0 +1,139 @@
+/*
+ * KBGenerator.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/util/oc_assert.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+
+#include "BenchmarkUtils.h"
+#include "KBGenerator.h"
+
+using namespace opencog;
+
+KBGenerator::KBGenerator(AtomSpace& as, const KBParameters& params)
+	: _as(as), _params(params), _rng(params.seed)
+{
+	OC_ASSERT(0 < _params.depth and 0 < _params.branching);
+}
+
+HandleSeq KBGenerator::inheritance_kb()
+{
+	return generate(CONCEPT_NODE, INHERITANCE_LINK);
+}
+
+HandleSeq KBGenerator::implication_kb()
+{
+	return generate(PREDICATE_NODE, IMPLICATION_LINK);
+}
+
+Handle KBGenerator::deduction_rule_base(int max_iter)
+{
+	Handle rbs = mk_rule_base("bench-deduction-rbs", max_iter);
+	add_deduction_rule(_as, rbs);
+	return rbs;
+}
+
+Handle KBGenerator::modus_ponens_rule_base(int max_iter)
+{
+	Handle rbs = mk_rule_base("bench-modus-ponens-rbs", max_iter);
+	add_modus_ponens_rule(_as, rbs);
+	return rbs;
+}
+
+Handle KBGenerator::get_source() const
+{
+	return _source;
+}
+
+Handle KBGenerator::get_target() const
+{
+	return _target;
+}
+
+const HandleSeq& KBGenerator::get_first_tree() const
+{
+	return _first_tree;
+}
+
+HandleSeq KBGenerator::generate(Type node_t, Type link_t)
+{
+	HandleSeq links;
+	size_t count = 0;
+	while (count < _params.concepts) {
+		// Generate a tree breadth first, one depth level at a time
+		Handle root = _as.add_node(node_t, "node-" + std::to_string(count++));
+		HandleSeq level{root};
+		for (size_t d = 0; d < _params.depth and count < _params.concepts; d++) {
+			HandleSeq children;
+			for (const Handle& parent : level) {
+				for (size_t b = 0; b < _params.branching
+					     and count < _params.concepts; b++) {
+					Handle child = _as.add_node(node_t,
+					                            "node-" + std::to_string(count++));
+					Handle link = _as.add_link(link_t, child, parent);
+					link->setTruthValue(random_tv());
+					links.push_back(link);
+					children.push_back(child);
+
+					// Remember the first deepest leaf of the first tree
+					if (not _source and d + 1 == _params.depth) {
+						_source = link;
+						_target = _as.add_link(link_t, child, root);
+					}
+				}
+			}
+			level = std::move(children);
+		}
+
+		// Leaves hold a TV as well, as premises of modus ponens
+		for (const Handle& leaf : level)
+			leaf->setTruthValue(random_tv());
+
+		if (_first_tree.empty())
+			_first_tree = links;
+	}
+
+	// If the forest is too small to reach the depth, fall back on the
+	// first link.
+	if (not _source and not links.empty()) {
+		_source = links.front();
+		_target = links.front();
+	}
+
+	return links;
+}
+
+Handle KBGenerator::mk_rule_base(const std::string& name, int max_iter)
+{
+	Handle rbs = _as.add_node(CONCEPT_NODE, std::string(name));
+	_as.add_link(EXECUTION_LINK,
+	             _as.add_node(SCHEMA_NODE, "URE:maximum-iterations"),
+	             rbs,
+	             _as.add_node(NUMBER_NODE, std::to_string(max_iter)));
+	return rbs;
+}
+
+TruthValuePtr KBGenerator::random_tv()
+{
+	// Strengths and confidences of at least 0.5, true enough for the
+	// rule formulas to produce conclusions.
+	return SimpleTruthValue::createTV(0.5 + 0.5 * _rng.randdouble(),
+	                                  0.5 + 0.5 * _rng.randdouble());
+}
@@ -0,0 +1,142 @@
+/*
+ * KBGenerator.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_KB_GENERATOR_H_
+#define _OPENCOG_URE_KB_GENERATOR_H_
+
+#include <opencog/util/mt19937ar.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+
+/**
+ * Parameters of a synthetic knowledge base
+ */
+struct KBParameters
+{
+	// Total number of concepts (or predicates)
+	size_t concepts = 1000;
+
+	// Depth of the trees, that is the length of the longest
+	// inheritance (or implication) chains.
+	size_t depth = 4;
+
+	// Number of children of each non-leaf concept
+	size_t branching = 2;
+
+	// Seed of the random generator producing the TVs
+	unsigned long seed = 0;
+};
+
+/**
+ * Generate synthetic knowledge bases and their matching rule bases,
+ * to benchmark the chainers at scale.
+ *
+ * A knowledge base is a forest of complete trees of the given depth
+ * and branching factor, with as many trees as necessary to reach the
+ * given number of concepts (the last one being truncated). Each child
+ * is linked to its parent, thus forming chains from the leaves to the
+ * roots, with random TVs that are true enough for the rules to apply.
+ */
+class KBGenerator
+{
+public:
+	KBGenerator(AtomSpace& as, const KBParameters& params=KBParameters());
+
+	/**
+	 * Generate a knowledge base of
+	 *
+	 * Inheritance (stv s c)
+	 *   Concept "child"
+	 *   Concept "parent"
+	 *
+	 * matching the rule base of deduction_rule_base. Return the
+	 * generated links.
+	 */
+	HandleSeq inheritance_kb();
+
+	/**
+	 * Generate a knowledge base of
+	 *
+	 * Implication (stv s c)
+	 *   Predicate "child"
+	 *   Predicate "parent"
+	 *
+	 * where the leaves hold TVs as well, matching the rule base of
+	 * modus_ponens_rule_base. Return the generated links.
+	 */
+	HandleSeq implication_kb();
+
+	/**
+	 * Generate a rule base with a deduction rule (see
+	 * add_deduction_rule) or a modus ponens rule (see
+	 * add_modus_ponens_rule), with max_iter as maximum number of
+	 * iterations. Return the rule base.
+	 */
+	Handle deduction_rule_base(int max_iter=100);
+	Handle modus_ponens_rule_base(int max_iter=100);
+
+	/**
+	 * Link from a deepest leaf of the first tree to its parent, to be
+	 * used as forward chainer source.
+	 */
+	Handle get_source() const;
+
+	/**
+	 * Link from a deepest leaf of the first tree to its root, to be
+	 * used as backward chainer target. Its proof requires depth - 1
+	 * rule applications.
+	 */
+	Handle get_target() const;
+
+	/**
+	 * Links of the first tree, the only knowledge relevant to the
+	 * target, to be used as backward chainer focus set.
+	 */
+	const HandleSeq& get_first_tree() const;
+
+private:
+	/**
+	 * Generate the forest with nodes of type node_t linked with
+	 * links of type link_t.
+	 */
+	HandleSeq generate(Type node_t, Type link_t);
+
+	/**
+	 * Create a rule base with given name and maximum number of
+	 * iterations.
+	 */
+	Handle mk_rule_base(const std::string& name, int max_iter);
+
+	TruthValuePtr random_tv();
+
+	AtomSpace& _as;
+	KBParameters _params;
+	MT19937RandGen _rng;
+
+	Handle _source;
+	Handle _target;
+	HandleSeq _first_tree;
+};
+
+} // ~namespace opencog
+
+#endif // _OPENCOG_URE_KB_GENERATOR_H_
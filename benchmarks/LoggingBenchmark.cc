@@ -0,0 +1,118 @@
+/*
+ * LoggingBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/ure/URELogger.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Cost of a debug log statement of the forward chainer step, with
+// its iteration prefix, while the URE logger is at the WARN level,
+// like in production runs.
+//
+// Eager: the prefix and the stream are built, the logger only
+// discards the message once formatted.
+static void BM_Log_eager(benchmark::State& state)
+{
+	setup_benchmark();
+	ure_logger().set_level(Logger::WARN);
+	int iteration = 0;
+	for (auto _ : state) {
+		std::string msgprfx = std::string("[I-")
+			+ std::to_string(iteration++) + "] ";
+		ure_logger().debug() << msgprfx << "Iterate one step";
+	}
+}
+BENCHMARK(BM_Log_eager);
+
+// Lazy: the level is checked first, nothing is built.
+static void BM_Log_lazy(benchmark::State& state)
+{
+	setup_benchmark();
+	ure_logger().set_level(Logger::WARN);
+	int iteration = 0;
+	for (auto _ : state) {
+		std::string msgprfx;
+		if (URE_LOG_ENABLED(DEBUG))
+			msgprfx = std::string("[I-")
+				+ std::to_string(iteration) + "] ";
+		LAZY_URE_LOG_DEBUG << msgprfx << "Iterate one step";
+		benchmark::DoNotOptimize(iteration++);
+	}
+}
+BENCHMARK(BM_Log_lazy);
+
+// Compiled out: what URE_LOG_ENABLED(DEBUG) expands to when built
+// with URE_LOG_MAX_LEVEL=WARN, the level check itself is removed.
+static void BM_Log_compiled_out(benchmark::State& state)
+{
+	setup_benchmark();
+	ure_logger().set_level(Logger::WARN);
+	int iteration = 0;
+	for (auto _ : state) {
+		if (Logger::DEBUG <= Logger::WARN
+		    and ure_logger().is_enabled(Logger::DEBUG))
+			ure_logger().debug() << "[I-" << iteration << "] "
+			                     << "Iterate one step";
+		benchmark::DoNotOptimize(iteration++);
+	}
+}
+BENCHMARK(BM_Log_compiled_out);
+
+// Eager versus lazy logging of a stream built in a loop, like the
+// rule weights of ControlPolicy::rule_weights. The size is the number
+// of entries.
+static void BM_Log_stream_eager(benchmark::State& state)
+{
+	setup_benchmark();
+	ure_logger().set_level(Logger::WARN);
+	for (auto _ : state) {
+		std::stringstream ss;
+		ss << "Rule weights:" << std::endl;
+		for (long i = 0; i < state.range(0); i++)
+			ss << 0.5 << " rule-" << i << std::endl;
+		ure_logger().debug() << ss.str();
+	}
+}
+BENCHMARK(BM_Log_stream_eager)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_Log_stream_lazy(benchmark::State& state)
+{
+	setup_benchmark();
+	ure_logger().set_level(Logger::WARN);
+	for (auto _ : state) {
+		if (URE_LOG_ENABLED(DEBUG)) {
+			std::stringstream ss;
+			ss << "Rule weights:" << std::endl;
+			for (long i = 0; i < state.range(0); i++)
+				ss << 0.5 << " rule-" << i << std::endl;
+			ure_logger().debug() << ss.str();
+		}
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_Log_stream_lazy)->RangeMultiplier(4)->Range(4, 256);
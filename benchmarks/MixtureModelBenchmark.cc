@@ -0,0 +1,80 @@
+/*
+ * MixtureModelBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/mt19937ar.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/ure/MixtureModel.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Mix models, akin to control rules, of random TVs. The size is the
+// number of models.
+static void BM_MixtureModel(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	Handle success = as.add_node(PREDICATE_NODE, "expansion-success");
+	HandleSet models;
+	for (long i = 0; i < state.range(0); i++) {
+		Handle model = as.add_link(IMPLICATION_LINK,
+		                           add_concept(as, "context-", i), success);
+		model->setTruthValue(
+			SimpleTruthValue::createTV(randGen().randdouble(),
+			                           randGen().randdouble()));
+		models.insert(model);
+	}
+	MixtureModel mm(models);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(mm());
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MixtureModel)->RangeMultiplier(4)->Range(2, 512)->Complexity();
+
+// Like BM_MixtureModel but with the statistics of the models
+// precalculated, as ControlPolicy does for control rules.
+static void BM_MixtureModel_stats(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	Handle success = as.add_node(PREDICATE_NODE, "expansion-success");
+	HandleSet models;
+	MixtureModel::ModelStatsMap stats;
+	for (long i = 0; i < state.range(0); i++) {
+		Handle model = as.add_link(IMPLICATION_LINK,
+		                           add_concept(as, "context-", i), success);
+		model->setTruthValue(
+			SimpleTruthValue::createTV(randGen().randdouble(),
+			                           randGen().randdouble()));
+		models.insert(model);
+		stats[model] = MixtureModel::model_stats(model);
+	}
+	MixtureModel mm(models, stats);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(mm());
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MixtureModel_stats)->RangeMultiplier(4)->Range(2, 512)->Complexity();
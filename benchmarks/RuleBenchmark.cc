@@ -0,0 +1,64 @@
+/*
+ * RuleBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/ure/Rule.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Unify a grounded inheritance source with all premises of a
+// deduction rule. The size is the number of premises.
+static void BM_Rule_unify_source(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	Handle rbs = as.add_node(CONCEPT_NODE, "bench-rbs");
+	Rule rule(add_deduction_rule(as, rbs, state.range(0)), rbs);
+	Handle source = as.add_link(INHERITANCE_LINK,
+	                            add_concept(as, "C", 0),
+	                            add_concept(as, "C", 1));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rule.unify_source(source));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Rule_unify_source)->RangeMultiplier(2)->Range(2, 32)->Complexity();
+
+// Unify a partially grounded inheritance target with the conclusion
+// of a deduction rule. The size is the number of premises.
+static void BM_Rule_unify_target(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	Handle rbs = as.add_node(CONCEPT_NODE, "bench-rbs");
+	Rule rule(add_deduction_rule(as, rbs, state.range(0)), rbs);
+	Handle target = as.add_link(INHERITANCE_LINK,
+	                            add_concept(as, "C", 0),
+	                            as.add_node(VARIABLE_NODE, "$T"));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rule.unify_target(target));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Rule_unify_target)->RangeMultiplier(2)->Range(2, 32)->Complexity();
@@ -0,0 +1,64 @@
+/*
+ * SourceSetBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/ure/UREConfig.h>
+#include <opencog/ure/forwardchainer/SourceSet.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Insert products into a source set of a single source. The size is
+// the number of products.
+static void BM_SourceSet_insert(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	Handle rbs = as.add_node(CONCEPT_NODE, "bench-rbs");
+	add_deduction_rule(as, rbs);
+	UREConfig config(as, rbs);
+	Handle source = as.add_link(INHERITANCE_LINK,
+	                            add_concept(as, "C", 0),
+	                            add_concept(as, "C", 1));
+	HandleSet products;
+	for (long i = 0; i < state.range(0); i++)
+		products.insert(as.add_link(INHERITANCE_LINK,
+		                            add_concept(as, "C", 0),
+		                            add_concept(as, "D", i)));
+
+	// The source set of the previous iteration is destroyed while
+	// timing is paused.
+	std::unique_ptr<SourceSet> sources;
+	for (auto _ : state) {
+		state.PauseTiming();
+		sources.reset(new SourceSet(config, source, Handle::UNDEFINED));
+		const Source& src = *sources->sources.front();
+		state.ResumeTiming();
+		sources->insert(products, src, 0.5);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SourceSet_insert)->RangeMultiplier(4)->Range(4, 4096)->Complexity();
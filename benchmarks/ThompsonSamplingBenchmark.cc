@@ -0,0 +1,69 @@
+/*
+ * ThompsonSamplingBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/mt19937ar.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/ure/ThompsonSampling.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Random TVs, of random strengths and confidences, one per action
+static TruthValueSeq mk_tvs(size_t n)
+{
+	TruthValueSeq tvs;
+	for (size_t i = 0; i < n; i++)
+		tvs.push_back(SimpleTruthValue::createTV(randGen().randdouble(),
+		                                         randGen().randdouble()));
+	return tvs;
+}
+
+// Calculate the action distribution. The size is the number of
+// actions.
+static void BM_ThompsonSampling_distribution(benchmark::State& state)
+{
+	setup_benchmark();
+	TruthValueSeq tvs = mk_tvs(state.range(0));
+	ThompsonSampling ts(tvs);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(ts.distribution());
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ThompsonSampling_distribution)
+	->RangeMultiplier(4)->Range(2, 512)->Complexity();
+
+// Select an action. The size is the number of actions.
+static void BM_ThompsonSampling_select(benchmark::State& state)
+{
+	setup_benchmark();
+	TruthValueSeq tvs = mk_tvs(state.range(0));
+	ThompsonSampling ts(tvs);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(ts());
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ThompsonSampling_select)
+	->RangeMultiplier(4)->Range(2, 512)->Complexity();
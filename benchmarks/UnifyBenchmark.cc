@@ -0,0 +1,89 @@
+/*
+ * UnifyBenchmark.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <functional>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/unify/Unify.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace opencog;
+
+// Build a balanced binary tree of InheritanceLinks of a given depth,
+// leaves being produced by mk_leaf given their index.
+static Handle mk_tree(AtomSpace& as, int depth,
+                      const std::function<Handle(size_t)>& mk_leaf,
+                      size_t& index)
+{
+	if (depth == 0)
+		return mk_leaf(index++);
+	Handle lhs = mk_tree(as, depth - 1, mk_leaf, index);
+	Handle rhs = mk_tree(as, depth - 1, mk_leaf, index);
+	return as.add_link(INHERITANCE_LINK, lhs, rhs);
+}
+
+// Unify a tree with a variable at every other leaf against the
+// grounded tree of the same shape. The size is the tree depth.
+static void BM_Unify(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	int depth = state.range(0);
+	size_t lhs_index = 0, rhs_index = 0;
+	Handle lhs = mk_tree(as, depth, [&](size_t i) {
+			return i % 2 ? as.add_node(VARIABLE_NODE, "$X" + std::to_string(i))
+				: add_concept(as, "C", i); }, lhs_index);
+	Handle rhs = mk_tree(as, depth, [&](size_t i) {
+			return add_concept(as, "C", i); }, rhs_index);
+
+	for (auto _ : state) {
+		Unify unify(lhs, rhs);
+		benchmark::DoNotOptimize(unify());
+	}
+	state.SetComplexityN(1 << depth);
+}
+BENCHMARK(BM_Unify)->DenseRange(1, 9, 2)->Complexity();
+
+// Unify two trees with variables on both sides. The size is the tree
+// depth.
+static void BM_Unify_variables(benchmark::State& state)
+{
+	setup_benchmark();
+	AtomSpace as;
+	int depth = state.range(0);
+	size_t lhs_index = 0, rhs_index = 0;
+	Handle lhs = mk_tree(as, depth, [&](size_t i) {
+			return i % 2 ? as.add_node(VARIABLE_NODE, "$X" + std::to_string(i))
+				: add_concept(as, "C", i); }, lhs_index);
+	Handle rhs = mk_tree(as, depth, [&](size_t i) {
+			return i % 2 ? add_concept(as, "C", i)
+				: as.add_node(VARIABLE_NODE, "$Y" + std::to_string(i)); },
+		rhs_index);
+
+	for (auto _ : state) {
+		Unify unify(lhs, rhs);
+		benchmark::DoNotOptimize(unify());
+	}
+	state.SetComplexityN(1 << depth);
+}
+BENCHMARK(BM_Unify_variables)->DenseRange(1, 9, 2)->Complexity();
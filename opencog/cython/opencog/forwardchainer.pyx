@@ -40,13 +40,52 @@ cdef class ForwardChainer:
         self._trace_as = trace_as
 
     def do_chain(self):
-        return self.chainer.do_chain()
+        # Release the GIL so that cancel can be called from another
+        # thread while chaining.
+        with nogil:
+            self.chainer.do_chain()
+
+    def cancel(self):
+        """Cancel chaining, can be called from another thread. Results
+        obtained so far remain available via get_results."""
+        self.chainer.cancel()
 
     def get_results(self):
         cdef cHandle res_handle = self.chainer.get_results()
         cdef Atom result = Atom.createAtom(res_handle)
         return result
 
+    def enable_profiling(self, enabled=True):
+        """Count and time the phases of chaining, must be called before
+        chaining. Can also be enabled with the URE:profile parameter."""
+        self.chainer.get_profiler().set_enabled(enabled)
+
+    def set_timeline(self, filename):
+        """Record the iterations and phases of chaining per thread, to
+        be written in Chrome trace-event JSON format to the given file
+        at the end of do_chain. Must be called before chaining."""
+        self.chainer.get_profiler().set_timeline(
+            shared_ptr[cTimeline](new cTimeline(filename.encode('UTF-8'))))
+
+    def get_profile(self):
+        """Return the statistics of the phases of chaining, as a
+        dictionary mapping phase names to counters and latencies in
+        nanoseconds. Empty unless profiling is enabled."""
+        return profile_to_dict(self.chainer.get_profiler())
+
+    def stream(self):
+        """Chain step by step and yield each new result as soon as it
+        is produced. Breaking out of the iteration stops chaining, the
+        results produced so far remain available via get_results."""
+        cdef size_t pos = 0
+        cdef vector[cHandle] new_results
+        while not self.chainer.termination():
+            self.chainer.do_step()
+            new_results = self.chainer.get_results_since(pos)
+            pos += new_results.size()
+            for i in range(new_results.size()):
+                yield Atom.createAtom(new_results[i])
+
     def __dealloc__(self):
         del self.chainer
         self._trace_as = None
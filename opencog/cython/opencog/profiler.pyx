@@ -0,0 +1,24 @@
+from libcpp.memory cimport shared_ptr
+from ure cimport cProfiler, cPhaseStats, cTimeline, Phase, PHASE_COUNT
+
+
+cdef profile_to_dict(cProfiler& profiler):
+    """Return the statistics of the phases that have been called at
+    least once, as a dictionary mapping phase names to dictionaries of
+    counters and latencies in nanoseconds."""
+    cdef cPhaseStats stats
+    profile = {}
+    for p in range(PHASE_COUNT):
+        stats = profiler.get_stats(<Phase>p)
+        if stats.count == 0:
+            continue
+        name = cProfiler.phase_name(<Phase>p).decode('UTF-8')
+        profile[name] = {'count': stats.count,
+                         'total_ns': stats.total_ns,
+                         'min_ns': stats.min_ns,
+                         'max_ns': stats.max_ns,
+                         'mean_ns': stats.mean_ns(),
+                         'p50_ns': stats.quantile_ns(0.5),
+                         'p99_ns': stats.quantile_ns(0.99),
+                         'histogram': list(stats.histogram)}
+    return profile
@@ -1,9 +1,44 @@
+from libc.stdint cimport uint64_t
+from libcpp.memory cimport shared_ptr
 from libcpp.set cimport set
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 from opencog.atomspace cimport cHandle, cAtomSpace
 from opencog.logger cimport cLogger
 
 
+cdef extern from "opencog/ure/Timeline.h" namespace "opencog":
+    cdef cppclass cTimeline "opencog::Timeline":
+        cTimeline(const string& filename)
+        size_t size()
+        void write(const string& filename) except +
+
+
+cdef extern from "opencog/ure/Profiler.h" namespace "opencog":
+    cdef enum Phase "opencog::Profiler::Phase":
+        PHASE_COUNT "opencog::Profiler::PHASE_COUNT"
+
+    cdef cppclass cPhaseStats "opencog::Profiler::PhaseStats":
+        uint64_t count
+        uint64_t total_ns
+        uint64_t min_ns
+        uint64_t max_ns
+        vector[uint64_t] histogram
+        double mean_ns()
+        uint64_t quantile_ns(double q)
+
+    cdef cppclass cProfiler "opencog::Profiler":
+        bint is_enabled()
+        void set_enabled(bint enabled)
+        void set_timeline(const shared_ptr[cTimeline]& timeline)
+        cPhaseStats get_stats(Phase phase)
+        void reset()
+        string to_string()
+
+        @staticmethod
+        const char* phase_name(Phase phase)
+
+
 cdef extern from "opencog/ure/forwardchainer/ForwardChainer.h" namespace "opencog":
     cdef cppclass cForwardChainer "opencog::ForwardChainer":
         cForwardChainer(cAtomSpace& kb_as,
@@ -14,8 +49,13 @@ cdef extern from "opencog/ure/forwardchainer/ForwardChainer.h" namespace "openco
                         cAtomSpace* trace_as,
                         const vector[cHandle]& focus_set) except +
 
-        void do_chain() except +
+        void do_chain() nogil except +
+        void cancel() nogil
+        void do_step() except +
+        bint termination() except +
         cHandle get_results() const
+        vector[cHandle] get_results_since(size_t pos) const
+        cProfiler& get_profiler()
 
 
 cdef extern from "opencog/ure/backwardchainer/Fitness.h" namespace "opencog::BITNodeFitness":
@@ -68,8 +108,13 @@ cdef extern from "opencog/ure/backwardchainer/BackwardChainer.h" namespace "open
                         cAtomSpace* control_as,
                         const cHandle& focus_set) except +
 
-        void do_chain() except +
+        void do_chain() nogil except +
+        void cancel() nogil
+        void do_step() except +
+        bint termination() except +
         cHandle get_results() const
+        vector[cHandle] get_results_since(size_t pos) const
+        cProfiler& get_profiler()
 
 
 cdef extern from "opencog/ure/URELogger.h" namespace "opencog":
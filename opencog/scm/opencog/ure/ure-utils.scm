@@ -28,11 +28,16 @@
 ;; -- ure-set-complexity-penalty -- Set the URE:complexity-penalty parameter
 ;; -- ure-set-jobs -- Set the URE:jobs parameter
 ;; -- ure-set-expansion-pool-size -- Set the URE:expansion-pool-size parameter
+;; -- ure-set-maximum-time -- Set the URE:maximum-time parameter
+;; -- ure-set-maximum-cpu-time -- Set the URE:maximum-cpu-time parameter
+;; -- ure-set-maximum-atoms-added -- Set the URE:maximum-atoms-added parameter
+;; -- ure-set-profile -- Set the URE:profile parameter
 ;; -- ure-set-fc-retry-exhausted-sources -- Set the URE:FC:retry-exhausted-sources parameter
 ;; -- ure-set-fc-full-rule-application -- Set the URE:FC:full-rule-application parameter
 ;; -- ure-set-bc-maximum-bit-size -- Set the URE:BC:maximum-bit-size
 ;; -- ure-set-bc-mm-complexity-penalty -- Set the URE:BC:MM:complexity-penalty
 ;; -- ure-set-bc-mm-compressiveness -- Set the URE:BC:MM:compressiveness
+;; -- ure-set-bc-maximum-bit-atoms -- Set the URE:BC:maximum-bit-atoms
 ;; -- ure-define-rbs -- Create a rbs that runs for a particular number of
 ;;                      iterations.
 ;; -- ure-logger-set-level! -- Set level of the URE logger
@@ -89,12 +94,20 @@
                  #:key
                  (vardecl (List))
                  (trace-as #f)
+                 (trace-file "")
                  (focus-set (Set))
+                 (on-result (List))
+                 (stop-when (List))
+                 (cancel-token (List))
                  (attention-allocation *unspecified*)
                  (maximum-iterations *unspecified*)
                  (complexity-penalty *unspecified*)
                  (jobs *unspecified*)
                  (expansion-pool-size *unspecified*)
+                 (maximum-time *unspecified*)
+                 (maximum-cpu-time *unspecified*)
+                 (maximum-atoms-added *unspecified*)
+                 (profile *unspecified*)
                  (fc-retry-exhausted-sources *unspecified*)
                  (fc-full-rule-application *unspecified*))
 "
@@ -103,12 +116,20 @@
   Usage: (cog-fc rbs source
                  #:vardecl vd
                  #:trace-as tas
+                 #:trace-file tf
                  #:focus-set fs
+                 #:on-result or
+                 #:stop-when sw
+                 #:cancel-token ct
                  #:attention-allocation aa
                  #:maximum-iterations mi
                  #:complexity-penalty cp
                  #:jobs jb
                  #:expansion-pool-size esp
+                 #:maximum-time mt
+                 #:maximum-cpu-time mct
+                 #:maximum-atoms-added maa
+                 #:profile pf
                  #:fc-retry-exhausted-sources res
                  #:fc-full-rule-application fra)
 
@@ -122,8 +143,26 @@
 
   tas: [optional] AtomSpace to record the inference traces.
 
+  tf: [optional] File where to write the inference traces in a compact
+      binary format, which unlike tas does not hold the traces in
+      memory. They can be converted back to atomese, as they would
+      have been recorded in tas, with (cog-ure-load-trace tf).
+
   fs: [optional] Focus set, a SetLink with all atoms to consider for
-      forward chaining.
+      forward chaining. Products are held in a child atomspace of the
+      current one while chaining, only the returned results are added
+      to the current atomspace.
+
+  or: [optional] Schema, such as (GroundedSchema "scm: f"), executed
+      over each new result as soon as it is produced.
+
+  sw: [optional] Predicate, such as (GroundedPredicate "scm: p"),
+      evaluated over each new result as soon as it is produced. Forward
+      chaining stops as soon as it evaluates to true over a result.
+
+  ct: [optional] Atom naming that call, so that it can be cancelled
+      from another thread with (cog-ure-cancel ct). Results obtained
+      so far are then returned.
 
   aa: [optional, default=#f] Whether the atoms involved with the
       inference are restricted to the attentional focus.
@@ -144,6 +183,19 @@
        the forward chainer), but also then the selection is more costly.
        Negative or null means unlimited (not recommended).
 
+  mt: [optional, default=-1] Maximum wall-clock time in seconds.
+      Negative means unlimited.
+
+  mct: [optional, default=-1] Maximum CPU time spent in the steps of
+       chaining, in seconds. Negative means unlimited.
+
+  maa: [optional, default=-1] Maximum number of distinct results
+       produced by chaining. Negative means unlimited.
+
+  pf: [optional, default=#f] Whether the phases of chaining are
+      counted and timed. The statistics are logged at INFO level and
+      can be retrieved with (cog-ure-profile rbs) afterwards.
+
   res: [optional, default=#f] Whether exhausted sources should be
        retried. A source is exhausted if all its valid rules (so that at
        least one rule premise unifies with the source) have been applied to
@@ -161,6 +213,9 @@
   ure-set-maximum-iterations and such.  If these parameters were not set
   at all, then the rule engine itself selects defaults in last resort.
   All parameter values are be logged at DEBUG level in the log file.
+  If a session is open over rbs, see cog-ure-open-session, the
+  parameters are fetched again for that call if any is passed, while
+  the rules of the session are reused.
 "
   ;; Set optional parameters
   (if (not (unspecified? attention-allocation))
@@ -173,6 +228,14 @@
       (ure-set-jobs rbs jobs))
   (if (not (unspecified? expansion-pool-size))
       (ure-set-expansion-pool-size rbs expansion-pool-size))
+  (if (not (unspecified? maximum-time))
+      (ure-set-maximum-time rbs maximum-time))
+  (if (not (unspecified? maximum-cpu-time))
+      (ure-set-maximum-cpu-time rbs maximum-cpu-time))
+  (if (not (unspecified? maximum-atoms-added))
+      (ure-set-maximum-atoms-added rbs maximum-atoms-added))
+  (if (not (unspecified? profile))
+      (ure-set-profile rbs profile))
   (if (not (unspecified? fc-retry-exhausted-sources))
       (ure-set-fc-retry-exhausted-sources rbs fc-retry-exhausted-sources))
   (if (not (unspecified? fc-full-rule-application))
@@ -180,39 +243,67 @@
 
   ;; Defined optional atomspaces and call the forward chainer
   (let* ((trace-enabled (cog-atomspace? trace-as))
-         (tas (if trace-enabled trace-as (cog-atomspace))))
-    (cog-mandatory-args-fc rbs source vardecl trace-enabled tas focus-set)))
+         (tas (if trace-enabled trace-as (cog-atomspace)))
+         (parameters-set
+          (not (every unspecified?
+                      (list attention-allocation maximum-iterations
+                            complexity-penalty jobs expansion-pool-size
+                            maximum-time maximum-cpu-time
+                            maximum-atoms-added profile
+                            fc-retry-exhausted-sources
+                            fc-full-rule-application)))))
+    (cog-mandatory-args-fc rbs source vardecl trace-enabled tas focus-set
+                           on-result stop-when cancel-token trace-file
+                           parameters-set)))
 
 (define* (cog-bc rbs target
                  #:key
                  (vardecl (List))
                  (trace-as #f)
+                 (trace-file "")
                  (control-as #f)
                  (focus-set (Set))
+                 (on-result (List))
+                 (stop-when (List))
+                 (cancel-token (List))
                  (attention-allocation *unspecified*)
                  (maximum-iterations *unspecified*)
                  (complexity-penalty *unspecified*)
                  (jobs *unspecified*)
                  (expansion-pool-size *unspecified*)
+                 (maximum-time *unspecified*)
+                 (maximum-cpu-time *unspecified*)
+                 (maximum-atoms-added *unspecified*)
+                 (profile *unspecified*)
                  (bc-maximum-bit-size *unspecified*)
                  (bc-mm-complexity-penalty *unspecified*)
-                 (bc-mm-compressiveness *unspecified*))
+                 (bc-mm-compressiveness *unspecified*)
+                 (bc-maximum-bit-atoms *unspecified*))
 "
   Backward Chainer call.
 
   Usage: (cog-bc rbs target
                  #:vardecl vd
                  #:trace-as tas
+                 #:trace-file tf
                  #:control-as cas
                  #:focus-set fs
+                 #:on-result or
+                 #:stop-when sw
+                 #:cancel-token ct
                  #:attention-allocation aa
                  #:maximum-iterations mi
                  #:complexity-penalty cp
                  #:jobs jb
                  #:expansion-pool-size esp
+                 #:maximum-time mt
+                 #:maximum-cpu-time mct
+                 #:maximum-atoms-added maa
+                 #:profile pf
                  #:bc-maximum-bit-size mbs
                  #:bc-mm-complexity-penalty mcp
-                 #:bc-mm-compressiveness mc)
+                 #:bc-mm-compressiveness mc
+                 #:bc-maximum-bit-atoms mba)
 
   rbs: ConceptNode representing a rulebase.
 
@@ -223,10 +314,28 @@
 
   tas: [optional] AtomSpace to record the back-inference traces.
 
+  tf: [optional] File where to write the back-inference traces in a
+      compact binary format, which unlike tas does not hold the traces
+      in memory. They can be converted back to atomese, as they would
+      have been recorded in tas, with (cog-ure-load-trace tf).
+
   cas: [optional] AtomSpace storing inference control rules.
 
-  fs: [optional] focus-set, a SetLink with all atoms to
-      consider for forward chaining (Not Implemented).
+  fs: [optional] Focus set, a SetLink with all atoms to consider for
+      backward chaining. Only groundings of rule premises under focus
+      are considered, and results are put under focus as they are
+      proven.
+
+  or: [optional] Schema, such as (GroundedSchema "scm: f"), executed
+      over each new result as soon as it is proven.
+
+  sw: [optional] Predicate, such as (GroundedPredicate "scm: p"),
+      evaluated over each new result as soon as it is proven. Backward
+      chaining stops as soon as it evaluates to true over a result.
+
+  ct: [optional] Atom naming that call, so that it can be cancelled
+      from another thread with (cog-ure-cancel ct). Results obtained
+      so far are then returned.
 
   aa: [optional, default=#f] Whether the atoms involved with the
       inference are restricted to the attentional focus.
@@ -247,6 +356,19 @@
        the forward chainer), but also then the selection is more costly.
        Negative or null means unlimited (not recommended).
 
+  mt: [optional, default=-1] Maximum wall-clock time in seconds.
+      Negative means unlimited.
+
+  mct: [optional, default=-1] Maximum CPU time spent in the steps of
+       chaining, in seconds. Negative means unlimited.
+
+  maa: [optional, default=-1] Maximum number of distinct results
+       produced by chaining. Negative means unlimited.
+
+  pf: [optional, default=#f] Whether the phases of chaining are
+      counted and timed. The statistics are logged at INFO level and
+      can be retrieved with (cog-ure-profile rbs) afterwards.
+
   mbs: [optional, default=-1] Maximum size of the inference tree pool
        to evolve. Negative means unlimited.
 
@@ -257,12 +379,18 @@
       control rules (how well a control rule can explain data outside of its
       context).
 
+  mba: [optional, default=-1] Maximum number of atoms in the atomspace
+       holding the inference tree pool. Negative means unlimited.
+
   Note that the defaults of the optional arguments are not determined
   here (although they attempt to be documented here).  That is the case
   in order not to overwrite existing parameters set by
   ure-set-maximum-iterations and such.  If these parameters were not set
   at all, then the rule engine itself selects defaults in last resort.
   All parameter values are be logged at DEBUG level in the log file.
+  If a session is open over rbs, see cog-ure-open-session, the
+  parameters are fetched again for that call if any is passed, while
+  the rules of the session are reused.
 "
   ;; Set optional parameters
   (if (not (unspecified? attention-allocation))
@@ -275,20 +403,91 @@
       (ure-set-jobs rbs jobs))
   (if (not (unspecified? expansion-pool-size))
       (ure-set-expansion-pool-size rbs expansion-pool-size))
+  (if (not (unspecified? maximum-time))
+      (ure-set-maximum-time rbs maximum-time))
+  (if (not (unspecified? maximum-cpu-time))
+      (ure-set-maximum-cpu-time rbs maximum-cpu-time))
+  (if (not (unspecified? maximum-atoms-added))
+      (ure-set-maximum-atoms-added rbs maximum-atoms-added))
+  (if (not (unspecified? profile))
+      (ure-set-profile rbs profile))
   (if (not (unspecified? bc-maximum-bit-size))
       (ure-set-bc-maximum-bit-size rbs bc-maximum-bit-size))
   (if (not (unspecified? bc-mm-complexity-penalty))
       (ure-set-bc-mm-complexity-penalty rbs bc-mm-complexity-penalty))
   (if (not (unspecified? bc-mm-compressiveness))
       (ure-set-bc-mm-compressiveness rbs bc-mm-compressiveness))
+  (if (not (unspecified? bc-maximum-bit-atoms))
+      (ure-set-bc-maximum-bit-atoms rbs bc-maximum-bit-atoms))
 
   ;; Defined optional atomspaces and call the backward chainer
   (let* ((trace-enabled (cog-atomspace? trace-as))
          (control-enabled (cog-atomspace? control-as))
          (tas (if trace-enabled trace-as (cog-atomspace)))
-         (cas (if control-enabled control-as (cog-atomspace))))
+         (cas (if control-enabled control-as (cog-atomspace)))
+         (parameters-set
+          (not (every unspecified?
+                      (list attention-allocation maximum-iterations
+                            complexity-penalty jobs expansion-pool-size
+                            maximum-time maximum-cpu-time
+                            maximum-atoms-added profile
+                            bc-maximum-bit-size bc-mm-complexity-penalty
+                            bc-mm-compressiveness bc-maximum-bit-atoms)))))
     (cog-mandatory-args-bc rbs target vardecl
-                           trace-enabled tas control-enabled cas focus-set)))
+                           trace-enabled tas control-enabled cas focus-set
+                           on-result stop-when cancel-token trace-file
+                           parameters-set)))
+
+(set-procedure-property! cog-ure-cancel 'documentation
+"
+ cog-ure-cancel CT
+    Cancel the forward or backward chaining launched with
+    #:cancel-token CT, or all of them if several are running under CT.
+    Return #t if such chaining is running, #f otherwise.
+")
+
+(set-procedure-property! cog-ure-open-session 'documentation
+"
+ cog-ure-open-session RBS
+    Load the configuration and rules of the rule-based system RBS once
+    and for all, so that subsequent calls of cog-fc and cog-bc over RBS
+    reuse them instead of reloading them. Meant for running many
+    queries against the same rule-based system.
+
+    If any parameter is passed as optional argument of cog-fc or
+    cog-bc, the parameters of RBS are fetched again for that call,
+    thus taking it into account. Otherwise parameters set afterwards,
+    such as with ure-set-maximum-iterations, are ignored, and so are
+    rules added to RBS, until the session is reopened.
+    Return #t if a session was already open and has been reloaded, #f
+    otherwise.
+")
+
+(set-procedure-property! cog-ure-close-session 'documentation
+"
+ cog-ure-close-session RBS
+    Close the session opened with cog-ure-open-session RBS. Return #t
+    if such session was open, #f otherwise.
+")
+
+(set-procedure-property! cog-ure-profile 'documentation
+"
+ cog-ure-profile RBS
+    Return a table of the number of calls and latencies of the phases
+    of the last forward or backward chaining over RBS, for which
+    profiling was enabled (see ure-set-profile). Return the empty
+    string if there is none.
+")
+
+(set-procedure-property! cog-ure-load-trace 'documentation
+"
+ cog-ure-load-trace TF
+    Convert the binary trace file TF, written by cog-fc or cog-bc with
+    #:trace-file TF, back to atomese into the current atomspace, as it
+    would have been recorded with #:trace-as. Return #t if the trace is
+    complete, #f if its chaining has been interrupted, in which case
+    the events recorded until then are converted.
+")
 
 (set-procedure-property! cog-ure-logger 'documentation
 "
@@ -849,6 +1048,58 @@
 "
   (ure-set-num-parameter rbs "URE:expansion-pool-size" value))
 
+(define (ure-set-maximum-time rbs value)
+"
+  Set the URE:maximum-time parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:maximum-time\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:maximum-time" value))
+
+(define (ure-set-maximum-cpu-time rbs value)
+"
+  Set the URE:maximum-cpu-time parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:maximum-cpu-time\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:maximum-cpu-time" value))
+
+(define (ure-set-maximum-atoms-added rbs value)
+"
+  Set the URE:maximum-atoms-added parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:maximum-atoms-added\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:maximum-atoms-added" value))
+
+(define (ure-set-profile rbs value)
+"
+  Set the URE:profile parameter of a given RBS
+
+  EvaluationLink (stv value 1)
+    PredicateNode \"URE:profile\"
+    rbs
+
+  If the provided value is a boolean, then it is automatically
+  converted into tv.
+"
+  (ure-set-fuzzy-bool-parameter rbs "URE:profile" value))
+
 (define (ure-set-fc-retry-exhausted-sources rbs value)
 "
   Set the URE:FC:retry-exhausted-sources parameter of a given RBS
@@ -914,6 +1165,19 @@
 "
   (ure-set-num-parameter rbs "URE:BC:MM:compressiveness" value))
 
+(define (ure-set-bc-maximum-bit-atoms rbs value)
+"
+  Set the URE:BC:maximum-bit-atoms parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:BC:maximum-bit-atoms\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:BC:maximum-bit-atoms" value))
+
 (define-public (ure-define-rbs rbs iteration)
 "
   Transforms the atom into a node that represents a rulebase and returns it.
@@ -1280,6 +1544,11 @@
   (export
           cog-fc
           cog-bc
+          cog-ure-cancel
+          cog-ure-open-session
+          cog-ure-close-session
+          cog-ure-profile
+          cog-ure-load-trace
           cog-ure-logger
           ure-define-add-rule
           ure-add-rule-alias
@@ -1300,11 +1569,16 @@
           ure-set-complexity-penalty
           ure-set-jobs
           ure-set-expansion-pool-size
+          ure-set-maximum-time
+          ure-set-maximum-cpu-time
+          ure-set-maximum-atoms-added
+          ure-set-profile
           ure-set-fc-retry-exhausted-sources
           ure-set-fc-full-rule-application
           ure-set-bc-maximum-bit-size
           ure-set-bc-mm-complexity-penalty
           ure-set-bc-mm-compressiveness
+          ure-set-bc-maximum-bit-atoms
           ure-define-rbs
           ure-get-forward-rule
           ure-logger-set-level!
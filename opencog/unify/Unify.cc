@@ -419,6 +419,36 @@ static Handle make_vardecl(const Handle& h)
 
 Handle Unify::substitute(BindLinkPtr bl, const HandleMap& var2val,
                          Handle vardecl, const AtomSpace* queried_as)
+{
+	return createLink(substitute_outgoings(bl, var2val, vardecl, queried_as),
+	                  bl->get_type());
+}
+
+// Return true iff var2val maps each variable of the given set to
+// itself, or does not map it at all.
+static bool is_identity(const HandleMap& var2val, const HandleSet& vars)
+{
+	for (const Handle& var : vars) {
+		auto it = var2val.find(var);
+		if (it != var2val.end() and it->second != var)
+			return false;
+	}
+	return true;
+}
+
+// Return true iff h contains some quotation, which substitution
+// would otherwise consume if needless.
+static bool has_quotation(const Handle& h)
+{
+	return contains_atomtype(h, QUOTE_LINK)
+		or contains_atomtype(h, UNQUOTE_LINK)
+		or contains_atomtype(h, LOCAL_QUOTE_LINK);
+}
+
+HandleSeq Unify::substitute_outgoings(BindLinkPtr bl,
+                                      const HandleMap& var2val,
+                                      Handle vardecl,
+                                      const AtomSpace* queried_as)
 {
 	// Perform substitution over the existing variable declaration, if
 	// no new alternative is provided.
@@ -434,12 +464,27 @@ Handle Unify::substitute(BindLinkPtr bl, const HandleMap& var2val,
 
 	const Variables& variables = bl->get_variables();
 
-	// Turn the map into a vector of new variable names/values
-	HandleSeq values = variables.make_sequence(var2val);
-
 	// Substituted BindLink outgoings
 	HandleSeq hs;
 
+	// Nothing to substitute, share the terms of bl
+	if (is_identity(var2val, variables.varset)
+	    and not has_quotation(bl->get_body())
+	    and not boost::algorithm::any_of(bl->get_implicand(), has_quotation)) {
+		hs.push_back(bl->get_body());
+		const HandleSeq& rewrites = bl->get_implicand();
+		hs.insert(hs.end(), rewrites.begin(), rewrites.end());
+		if (queried_as)
+			hs[0] = remove_constant_clauses(vardecl, hs[0], queried_as);
+		vardecl = filter_vardecl(vardecl, hs);
+		if (vardecl)
+			hs.insert(hs.begin(), vardecl);
+		return hs;
+	}
+
+	// Turn the map into a vector of new variable names/values
+	HandleSeq values = variables.make_sequence(var2val);
+
 	// Perform substitution over the pattern term, then remove
 	// constant clauses
 	Handle clauses = variables.substitute_nocheck(bl->get_body(), values);
@@ -469,8 +514,7 @@ Handle Unify::substitute(BindLinkPtr bl, const HandleMap& var2val,
 	if (vardecl)
 		hs.insert(hs.begin(), vardecl);
 
-	// Create the substituted BindLink
-	return createLink(std::move(hs), bl->get_type());
+	return hs;
 }
 
 Handle Unify::substitute_vardecl(const Handle& vardecl,
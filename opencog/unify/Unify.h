@@ -402,6 +402,22 @@ public:
 	                         Handle vardecl=Handle::UNDEFINED,
 	                         const AtomSpace* queried_as=nullptr);
 
+	/**
+	 * Like substitute above but return the outgoings of the
+	 * substituted BindLink, [vardecl,] pattern, rewrite..., instead
+	 * of creating it. Useful when the caller only needs to build
+	 * another scope link out of them, as creating a BindLink triggers
+	 * the compilation of its pattern.
+	 *
+	 * If var2val leaves all variables of bl unchanged then the
+	 * pattern and rewrite terms of bl are returned as is, thus shared
+	 * with bl rather than copied.
+	 */
+	static HandleSeq substitute_outgoings(BindLinkPtr bl,
+	                                      const HandleMap& var2val,
+	                                      Handle vardecl=Handle::UNDEFINED,
+	                                      const AtomSpace* queried_as=nullptr);
+
 	/**
 	 * Substitute the variable declaration of a BindLink. Remove
 	 * variables that are substituted by values. If all variables are
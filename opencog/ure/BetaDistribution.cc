@@ -21,6 +21,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+#include <boost/math/special_functions/gamma.hpp>
+
 #include "BetaDistribution.h"
 #include "URELogger.h"
 
@@ -28,6 +37,126 @@
 
 namespace opencog {
 
+// Helpers of the batch evaluation of the cdf and pdf over regularly
+// spaced points, see BetaDistribution::cdf and BetaDistribution::pdf.
+//
+// The cdf at x is the regularized incomplete beta function
+//
+// I_x(a, b) = x^a (1-x)^b / (a B(a, b)) * CF(a, b, x)
+//
+// where CF is a continued fraction converging rapidly for
+// x < (a+1)/(a+b+2), otherwise I_x(a, b) = 1 - I_{1-x}(b, a) is
+// used. The power terms x^a (1-x)^b / B(a, b) share their
+// normalization across points, and the pdf is derived from them.
+//
+// boost::math::lgamma is used rather than std::lgamma, which is not
+// thread-safe as it sets the global signgam.
+namespace {
+
+// Minimum parameter above which lgamma is calculated with Stirling's
+// series, to avoid cancellations between large terms
+const double stirling_threshold = 10.0;
+
+// Remainder of Stirling's series of lgamma, that is
+//
+// lgamma(a) - ((a - 0.5) log(a) - a + 0.5 log(2 pi))
+//
+// accurate to 1e-12 for a >= stirling_threshold
+double lgamma_remainder(double a)
+{
+	double a2 = 1.0 / (a * a);
+	return (1.0 / 12 - a2 * (1.0 / 360 - a2 * (1.0 / 1260 - a2 / 1680))) / a;
+}
+
+// Calculate the log of the power terms x^a (1-x)^b / B(a, b), the
+// terms not depending on x being calculated once.
+class BetaPowerTerms
+{
+public:
+	BetaPowerTerms(double a, double b)
+		: _a(a), _b(b), _s(a + b),
+		  _large(stirling_threshold <= a and stirling_threshold <= b)
+	{
+		if (_large)
+			_c = 0.5 * std::log(a * b / _s) - 0.5 * std::log(2 * M_PI)
+				- lgamma_remainder(a) - lgamma_remainder(b)
+				+ lgamma_remainder(_s);
+		else if (a < stirling_threshold and b < stirling_threshold)
+			_c = boost::math::lgamma(_s) - boost::math::lgamma(a)
+				- boost::math::lgamma(b);
+		else if (a < stirling_threshold)
+			_c = -boost::math::lgamma(a) + (b - 0.5) * std::log1p(a / b)
+				+ a * std::log(_s) - a
+				- lgamma_remainder(b) + lgamma_remainder(_s);
+		else
+			_c = -boost::math::lgamma(b) + (a - 0.5) * std::log1p(b / a)
+				+ b * std::log(_s) - b
+				- lgamma_remainder(a) + lgamma_remainder(_s);
+	}
+
+	// Given x, y = 1 - x, and their logs, lx and ly
+	double log(double x, double lx, double ly) const
+	{
+		if (_large) {
+			double d = x * _s - _a;
+			return _a * std::log1p(d / _a) + _b * std::log1p(-d / _b) + _c;
+		}
+		return _a * lx + _b * ly + _c;
+	}
+
+private:
+	double _a, _b, _s;
+	bool _large;
+	double _c;
+};
+
+const int cf_max_iterations = 10000;
+const double cf_epsilon = 1e-15;
+const double cf_tiny = 1e-300;
+
+// Evaluate CF(a, b, x) with the modified Lentz's method, return NaN
+// if it does not converge.
+double ibeta_cf(double a, double b, double x)
+{
+	double qab = a + b, qap = a + 1, qam = a - 1, c = 1,
+		d = 1 - qab * x / qap;
+	if (std::fabs(d) < cf_tiny)
+		d = cf_tiny;
+	d = 1 / d;
+	double h = d;
+	for (int m = 1; m <= cf_max_iterations; m++) {
+		int m2 = 2 * m;
+
+		// Even step
+		double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+		d = 1 + aa * d;
+		if (std::fabs(d) < cf_tiny)
+			d = cf_tiny;
+		c = 1 + aa / c;
+		if (std::fabs(c) < cf_tiny)
+			c = cf_tiny;
+		d = 1 / d;
+		h *= d * c;
+
+		// Odd step
+		aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+		d = 1 + aa * d;
+		if (std::fabs(d) < cf_tiny)
+			d = cf_tiny;
+		c = 1 + aa / c;
+		if (std::fabs(c) < cf_tiny)
+			c = cf_tiny;
+		d = 1 / d;
+		double del = d * c;
+		h *= del;
+		if (std::fabs(del - 1) < cf_epsilon)
+			return h;
+	}
+	return NAN;
+}
+
+} // ~namespace
+
 BetaDistribution::BetaDistribution(const TruthValuePtr& tv,
                                    double p_alpha, double p_beta)
 	// TODO should be replaced by tv->get_mode() once implemented
@@ -65,10 +194,25 @@ double BetaDistribution::variance() const
 
 std::vector<double> BetaDistribution::cdf(int bins) const
 {
+	double a = alpha(), b = beta(), x_sym = (a + 1) / (a + b + 2);
+	BetaPowerTerms power_terms(a, b);
 	std::vector<double> cdf;
+	cdf.reserve(bins);
 	for (int x_idx = 0; x_idx < bins; x_idx++) {
-		double x = (x_idx + 1.0) / bins,
-			r = boost::math::cdf(_beta_distribution, std::min(1.0, x));
+		double x = (x_idx + 1.0) / bins, y = (bins - x_idx - 1.0) / bins;
+		if (y <= 0) {
+			cdf.push_back(boost::math::cdf(_beta_distribution, 1.0));
+			continue;
+		}
+
+		// If the power terms underflow, so does the distance of the
+		// cdf to 0 or 1.
+		double pt = std::exp(power_terms.log(x, std::log(x), std::log(y))),
+			r = x < x_sym ?
+			(pt == 0 ? 0 : pt * ibeta_cf(a, b, x) / a) :
+			(pt == 0 ? 1 : 1 - pt * ibeta_cf(b, a, y) / b);
+		if (std::isnan(r))
+			r = boost::math::cdf(_beta_distribution, x);
 		cdf.push_back(r);
 	}
 	return cdf;
@@ -76,11 +220,19 @@ std::vector<double> BetaDistribution::cdf(int bins) const
 
 std::vector<double> BetaDistribution::pdf(int bins) const
 {
+	BetaPowerTerms power_terms(alpha(), beta());
 	std::vector<double> pdf;
+	pdf.reserve(bins);
 	for (int x_idx = 0; x_idx < bins; x_idx++) {
-		double x = (x_idx + 1.0) / bins,
-			r = boost::math::pdf(_beta_distribution, std::min(1.0, x));
-		pdf.push_back(r);
+		double x = (x_idx + 1.0) / bins, y = (bins - x_idx - 1.0) / bins;
+		if (y <= 0) {
+			pdf.push_back(boost::math::pdf(_beta_distribution, 1.0));
+			continue;
+		}
+
+		// pdf(x) = x^(a-1) (1-x)^(b-1) / B(a, b)
+		double lx = std::log(x), ly = std::log(y);
+		pdf.push_back(std::exp(power_terms.log(x, lx, ly) - lx - ly));
 	}
 	return pdf;
 }
@@ -130,8 +282,103 @@ BetaDistribution mk_beta_distribution(const TruthValuePtr& tv) {
 	return BetaDistribution(tv);
 }
 
-TruthValuePtr mk_stv(double mean, double variance,
-                     double prior_alpha, double prior_beta)
+namespace {
+
+// Memos of mk_stv and memo_cdf. Their arguments are quantized to
+// memo_mantissa_bits bits of mantissa so that arguments only
+// differing by rounding errors share an entry. A memo is emptied
+// once it reaches memo_max_size entries to bound its memory.
+const int memo_mantissa_bits = 32;
+const size_t memo_max_size = 1 << 16;
+
+bool is_finite(std::initializer_list<double> xs)
+{
+	return std::all_of(xs.begin(), xs.end(),
+	                   [](double x) { return std::isfinite(x); });
+}
+
+// Quantize a finite double into an integer encoding both its
+// exponent and its rounded mantissa.
+int64_t quantize(double x)
+{
+	int exp;
+	double mantissa = std::frexp(x, &exp);
+	int64_t q = std::llround(std::ldexp(mantissa, memo_mantissa_bits));
+	return ((int64_t)exp << (memo_mantissa_bits + 2)) + q;
+}
+
+template<typename K, typename V>
+class Memo
+{
+public:
+	typedef K Key;
+	typedef V Value;
+
+	/**
+	 * Return the value associated to key, calling calculate to obtain
+	 * it if missing. calculate is called outside of the lock, so
+	 * that threads do not wait on each other's evaluations, at the
+	 * cost of occasionally calculating the same value twice.
+	 */
+	template<typename Calculate>
+	Value operator()(const Key& key, const Calculate& calculate)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			auto it = _values.find(key);
+			if (it != _values.end()) {
+				_stats.hits++;
+				return it->second;
+			}
+			_stats.misses++;
+		}
+		Value value = calculate();
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (memo_max_size <= _values.size())
+			_values.clear();
+		_values.emplace(key, value);
+		return value;
+	}
+
+	MemoStats stats() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _stats;
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_values.clear();
+		_stats = MemoStats();
+	}
+
+private:
+	mutable std::mutex _mutex;
+	std::unordered_map<Key, Value, boost::hash<Key>> _values;
+	MemoStats _stats;
+};
+
+// Keyed on (mean, variance, prior_alpha, prior_beta)
+typedef Memo<std::array<int64_t, 4>, TruthValuePtr> STVMemo;
+
+// Keyed on (count, mean, prior_alpha, prior_beta, bins)
+typedef Memo<std::array<int64_t, 5>, std::vector<double>> CDFMemo;
+
+STVMemo& stv_memo()
+{
+	static STVMemo memo;
+	return memo;
+}
+
+CDFMemo& cdf_memo()
+{
+	static CDFMemo memo;
+	return memo;
+}
+
+TruthValuePtr calculate_stv(double mean, double variance,
+                            double prior_alpha, double prior_beta)
 {
 	using boost::math::beta_distribution;
 	double alpha = beta_distribution<double>::find_alpha(mean, variance),
@@ -173,9 +420,72 @@ TruthValuePtr mk_stv(double mean, double variance,
 	return SimpleTruthValue::createTV(mode, confidence);
 }
 
+} // ~namespace
+
+TruthValuePtr mk_stv(double mean, double variance,
+                     double prior_alpha, double prior_beta)
+{
+	if (not is_finite({mean, variance, prior_alpha, prior_beta}))
+		return calculate_stv(mean, variance, prior_alpha, prior_beta);
+
+	STVMemo::Key key{quantize(mean), quantize(variance),
+	                 quantize(prior_alpha), quantize(prior_beta)};
+	return stv_memo()(key, [&]() {
+			return calculate_stv(mean, variance, prior_alpha, prior_beta); });
+}
+
+std::vector<double> memo_cdf(const TruthValuePtr& tv, int bins,
+                             double prior_alpha, double prior_beta)
+{
+	double count = tv->get_count(), mean = tv->get_mean();
+	if (not is_finite({count, mean, prior_alpha, prior_beta}))
+		return BetaDistribution(tv, prior_alpha, prior_beta).cdf(bins);
+
+	CDFMemo::Key key{quantize(count), quantize(mean),
+	                 quantize(prior_alpha), quantize(prior_beta), bins};
+	return cdf_memo()(key, [&]() {
+			return BetaDistribution(tv, prior_alpha, prior_beta).cdf(bins); });
+}
+
+double MemoStats::hit_rate() const
+{
+	size_t total = hits + misses;
+	return total == 0 ? 0.0 : (double)hits / total;
+}
+
+std::string MemoStats::to_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	ss << indent << "hits = " << hits
+	   << ", misses = " << misses
+	   << ", hit rate = " << hit_rate();
+	return ss.str();
+}
+
+MemoStats mk_stv_memo_stats()
+{
+	return stv_memo().stats();
+}
+
+MemoStats cdf_memo_stats()
+{
+	return cdf_memo().stats();
+}
+
+void clear_beta_distribution_memos()
+{
+	stv_memo().clear();
+	cdf_memo().clear();
+}
+
 std::string oc_to_string(const BetaDistribution& bd, const std::string& indent)
 {
 	return bd.to_string(indent);
 }
 
+std::string oc_to_string(const MemoStats& ms, const std::string& indent)
+{
+	return ms.to_string(indent);
+}
+
 } // ~namespace opencog
@@ -85,6 +85,10 @@ public:
 	 *
 	 * The cdf at the origin is ignored because it is always 0. The
 	 * last one is always 1 but is included for completeness.
+	 *
+	 * All points are evaluated in one pass, sharing the normalization
+	 * of the regularized incomplete beta function, which agrees with
+	 * boost::math::cdf to 1e-9, and is much faster.
 	 */
 	std::vector<double> cdf(int bins) const;
 
@@ -99,6 +103,9 @@ public:
 	 *
 	 * The pdf at the origin is ignored because it is always 0. The
 	 * last one is always 0 but is included for completeness.
+	 *
+	 * Like cdf, all points are evaluated in one pass, agreeing with
+	 * boost::math::pdf to a relative 1e-9.
 	 */
 	std::vector<double> pdf(int bins) const;
 
@@ -130,9 +137,50 @@ private:
 // Helpers
 BetaDistribution mk_beta_distribution(const TruthValuePtr& tv);
 
+/**
+ * Build a simple TV of a beta-distribution with the given mean and
+ * variance.
+ *
+ * The result is memoized, keyed on mean, variance and prior
+ * quantized to a relative precision of 2^-32 (about 2e-10), so that
+ * the special functions are only evaluated once per distinct
+ * distribution.
+ */
 TruthValuePtr mk_stv(double mean, double variance,
                      double prior_alpha=1.0, double prior_beta=1.0);
 
+/**
+ * Like BetaDistribution(tv, prior_alpha, prior_beta).cdf(bins), but
+ * memoized, keyed on the count and the mean of tv, and the prior,
+ * quantized like in mk_stv.
+ */
+std::vector<double> memo_cdf(const TruthValuePtr& tv, int bins,
+                             double prior_alpha=1.0, double prior_beta=1.0);
+
+/**
+ * Number of hits and misses of a memo.
+ */
+struct MemoStats
+{
+	size_t hits = 0;
+	size_t misses = 0;
+
+	double hit_rate() const;
+
+	std::string to_string(const std::string& indent=empty_string) const;
+};
+
+/**
+ * Return the statistics of the memos of mk_stv and memo_cdf.
+ */
+MemoStats mk_stv_memo_stats();
+MemoStats cdf_memo_stats();
+
+/**
+ * Empty the memos of mk_stv and memo_cdf and reset their statistics.
+ */
+void clear_beta_distribution_memos();
+
 // Debugging helpers see
 // http://wiki.opencog.org/w/Development_standards#Print_OpenCog_Objects
 // The reason indent is not an optional argument with default is
@@ -140,6 +188,8 @@ TruthValuePtr mk_stv(double mean, double variance,
 // http://stackoverflow.com/questions/16734783 for more explanation.
 std::string oc_to_string(const BetaDistribution& bd,
                          const std::string& indent=empty_string);
+std::string oc_to_string(const MemoStats& ms,
+                         const std::string& indent=empty_string);
 
 } // namespace opencog
 
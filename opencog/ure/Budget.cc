@@ -0,0 +1,96 @@
+/*
+ * Budget.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <time.h>
+
+#include "Budget.h"
+
+using namespace opencog;
+
+Budget::Budget(const UREConfig& config, const AtomsAddedCounter& atoms_added)
+	: _config(config), _atoms_added(atoms_added), _started(false), _cpu_time(0)
+{
+}
+
+void Budget::start()
+{
+	if (_started)
+		return;
+	_started = true;
+	_start_time = std::chrono::steady_clock::now();
+}
+
+Budget::Step::Step(Budget& budget)
+	: _budget(budget), _start_cpu_time(thread_cpu_time())
+{
+}
+
+Budget::Step::~Step()
+{
+	_budget._cpu_time += thread_cpu_time() - _start_cpu_time;
+}
+
+int64_t Budget::thread_cpu_time()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+std::string Budget::exhausted() const
+{
+	if (not _started)
+		return "";
+
+	double mt = _config.get_maximum_time();
+	if (0 <= mt and mt <= elapsed_time())
+		return "reached the maximum wall-clock time";
+
+	double mct = _config.get_maximum_cpu_time();
+	if (0 <= mct and mct <= elapsed_cpu_time())
+		return "reached the maximum CPU time";
+
+	double maa = _config.get_maximum_atoms_added();
+	if (0 <= maa and maa <= atoms_added())
+		return "reached the maximum number of atoms added";
+
+	return "";
+}
+
+double Budget::elapsed_time() const
+{
+	if (not _started)
+		return 0.0;
+	std::chrono::duration<double> d = std::chrono::steady_clock::now() - _start_time;
+	return d.count();
+}
+
+double Budget::elapsed_cpu_time() const
+{
+	return _cpu_time / 1e9;
+}
+
+double Budget::atoms_added() const
+{
+	if (not _started)
+		return 0.0;
+	return _atoms_added();
+}
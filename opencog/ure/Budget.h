@@ -0,0 +1,110 @@
+/*
+ * Budget.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_BUDGET_H_
+#define _OPENCOG_URE_BUDGET_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "UREConfig.h"
+
+namespace opencog
+{
+
+/**
+ * Keep track of the resources consumed by a chainer since it has
+ * started, and tell whether the time and memory budgets of its
+ * configuration, if any, are exhausted.
+ *
+ * The CPU time is the one of the threads running the steps of the
+ * chainer, accumulated across steps, see Budget::Step, so that jobs
+ * run concurrently, see FCScheduler, are not charged for each
+ * other. Likewise the atoms added are the products of the chainer
+ * only, as counted by the function given at construction.
+ */
+class Budget
+{
+public:
+	/**
+	 * Function returning the number of atoms added by the chainer
+	 * so far, typically its number of distinct products.
+	 */
+	typedef std::function<size_t()> AtomsAddedCounter;
+
+	Budget(const UREConfig& config, const AtomsAddedCounter& atoms_added);
+
+	/**
+	 * Start measuring the resources consumed from now on. Does
+	 * nothing if already started.
+	 */
+	void start();
+
+	/**
+	 * Charge the CPU time of the calling thread, from construction
+	 * to destruction, to the budget. Meant to be scoped over a step
+	 * of the chainer, steps may run concurrently.
+	 */
+	class Step
+	{
+	public:
+		Step(Budget& budget);
+		~Step();
+
+	private:
+		Budget& _budget;
+		int64_t _start_cpu_time;
+	};
+
+	/**
+	 * Return a message describing the first exhausted budget, or the
+	 * empty string if none is.
+	 */
+	std::string exhausted() const;
+
+	/**
+	 * Resources consumed so far
+	 */
+	double elapsed_time() const;      // Wall-clock seconds
+	double elapsed_cpu_time() const;  // CPU seconds of the steps
+	double atoms_added() const;
+
+private:
+	// CPU time of the calling thread in nanoseconds
+	static int64_t thread_cpu_time();
+
+	const UREConfig& _config;
+
+	AtomsAddedCounter _atoms_added;
+
+	bool _started;
+
+	std::chrono::steady_clock::time_point _start_time;
+
+	// CPU time in nanoseconds accumulated by the terminated steps
+	std::atomic<int64_t> _cpu_time;
+};
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_BUDGET_H_ */
@@ -0,0 +1,79 @@
+/*
+ * CancellationToken.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <mutex>
+#include <unordered_map>
+
+#include "CancellationToken.h"
+
+namespace opencog {
+
+static std::unordered_multimap<Handle, CancellationTokenPtr> cancellation_tokens;
+static std::mutex cancellation_tokens_mutex;
+
+void register_cancellation_token(const Handle& name,
+                                 const CancellationTokenPtr& token)
+{
+	std::lock_guard<std::mutex> lock(cancellation_tokens_mutex);
+	cancellation_tokens.emplace(name, token);
+}
+
+void unregister_cancellation_token(const Handle& name,
+                                   const CancellationTokenPtr& token)
+{
+	std::lock_guard<std::mutex> lock(cancellation_tokens_mutex);
+	auto range = cancellation_tokens.equal_range(name);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second == token) {
+			cancellation_tokens.erase(it);
+			return;
+		}
+	}
+}
+
+bool cancel_registered_token(const Handle& name)
+{
+	std::lock_guard<std::mutex> lock(cancellation_tokens_mutex);
+	auto range = cancellation_tokens.equal_range(name);
+	for (auto it = range.first; it != range.second; ++it)
+		it->second->cancel();
+	return range.first != range.second;
+}
+
+CancellationRegistration::CancellationRegistration(const Handle& name)
+	: _name(name), _token(createCancellationToken())
+{
+	if (_name)
+		register_cancellation_token(_name, _token);
+}
+
+CancellationRegistration::~CancellationRegistration()
+{
+	if (_name)
+		unregister_cancellation_token(_name, _token);
+}
+
+const CancellationTokenPtr& CancellationRegistration::get_token() const
+{
+	return _token;
+}
+
+} // ~namespace opencog
@@ -0,0 +1,96 @@
+/*
+ * CancellationToken.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_CANCELLATION_TOKEN_H_
+#define _OPENCOG_URE_CANCELLATION_TOKEN_H_
+
+#include <atomic>
+#include <memory>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+
+/**
+ * Thread-safe flag telling a chainer to stop as soon as possible.
+ * The chainer checks it between steps and before applying rules,
+ * thus results obtained so far remain available.
+ */
+class CancellationToken
+{
+public:
+	CancellationToken() : _cancelled(false) {}
+
+	void cancel() { _cancelled = true; }
+	bool is_cancelled() const { return _cancelled; }
+
+private:
+	std::atomic<bool> _cancelled;
+};
+
+typedef std::shared_ptr<CancellationToken> CancellationTokenPtr;
+#define createCancellationToken std::make_shared<CancellationToken>
+
+/**
+ * Registry of cancellation tokens named by atoms, so that chaining
+ * launched from scheme or python can be cancelled from another thread
+ * by naming it. Several tokens may be registered under the same name,
+ * such as of concurrent chainings, then cancelling that name cancels
+ * them all.
+ */
+
+// Register token under name
+void register_cancellation_token(const Handle& name,
+                                 const CancellationTokenPtr& token);
+
+// Unregister token from name, leaving other tokens under name
+// registered.
+void unregister_cancellation_token(const Handle& name,
+                                   const CancellationTokenPtr& token);
+
+// Cancel all tokens registered under name. Return true if there is
+// any, false otherwise.
+bool cancel_registered_token(const Handle& name);
+
+/**
+ * Register a new token under name for the lifetime of that object,
+ * so that it is unregistered even if chaining throws. If name is
+ * undefined the token is not registered.
+ */
+class CancellationRegistration
+{
+public:
+	CancellationRegistration(const Handle& name);
+	~CancellationRegistration();
+
+	CancellationRegistration(const CancellationRegistration&) = delete;
+	CancellationRegistration& operator=(const CancellationRegistration&) = delete;
+
+	const CancellationTokenPtr& get_token() const;
+
+private:
+	Handle _name;
+	CancellationTokenPtr _token;
+};
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_CANCELLATION_TOKEN_H_ */
@@ -0,0 +1,329 @@
+/*
+ * Checkpoint.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atoms/truthvalue/CountTruthValue.h>
+
+#include "Checkpoint.h"
+
+using namespace opencog;
+
+static const std::string checkpoint_magic = "URECKPT";
+static const size_t checkpoint_version = 2;
+
+// Atom and rule tags
+enum : unsigned char { UNDEFINED_TAG, NODE_TAG, LINK_TAG, REFERENCE_TAG };
+
+/////////////////////
+// CheckpointWriter //
+/////////////////////
+
+CheckpointWriter::CheckpointWriter(std::ostream& out) : _out(out)
+{
+}
+
+void CheckpointWriter::write_header(char kind)
+{
+	_out.write(checkpoint_magic.data(), checkpoint_magic.size());
+	write_size(checkpoint_version);
+	_out.put(kind);
+}
+
+void CheckpointWriter::write_bool(bool b)
+{
+	_out.put(b ? 1 : 0);
+}
+
+void CheckpointWriter::write_size(size_t n)
+{
+	// LEB128, 7 bits per byte, the highest bit tells whether more
+	// bytes follow.
+	do {
+		unsigned char byte = n & 0x7f;
+		n >>= 7;
+		if (n)
+			byte |= 0x80;
+		_out.put(byte);
+	} while (n);
+}
+
+void CheckpointWriter::write_double(double d)
+{
+	// Little endian, whatever the architecture
+	uint64_t bits;
+	std::memcpy(&bits, &d, sizeof(bits));
+	for (int i = 0; i < 8; i++)
+		_out.put((bits >> (8 * i)) & 0xff);
+}
+
+void CheckpointWriter::write_string(const std::string& str)
+{
+	write_size(str.size());
+	_out.write(str.data(), str.size());
+}
+
+void CheckpointWriter::write_handle(const Handle& h)
+{
+	if (not h) {
+		_out.put(UNDEFINED_TAG);
+		return;
+	}
+
+	auto it = _handle_index.find(h);
+	if (it != _handle_index.end()) {
+		_out.put(REFERENCE_TAG);
+		write_size(it->second);
+		return;
+	}
+
+	// Outgoings are written first so that the index of h is assigned
+	// in the same order when reading.
+	if (h->is_node()) {
+		_out.put(NODE_TAG);
+		write_string(nameserver().getTypeName(h->get_type()));
+		write_string(h->get_name());
+	} else {
+		_out.put(LINK_TAG);
+		write_string(nameserver().getTypeName(h->get_type()));
+		write_handles(h->getOutgoingSet());
+	}
+	write_tv(h->getTruthValue());
+	size_t idx = _handle_index.size();
+	_handle_index[h] = idx;
+}
+
+void CheckpointWriter::write_handles(const HandleSeq& hs)
+{
+	write_size(hs.size());
+	for (const Handle& h : hs)
+		write_handle(h);
+}
+
+void CheckpointWriter::write_tv(const TruthValuePtr& tv)
+{
+	bool is_default = not tv or tv->isDefaultTV();
+	write_bool(not is_default);
+	if (not is_default) {
+		write_double(tv->get_mean());
+		write_double(tv->get_confidence());
+		bool is_simple = tv->get_type() == SIMPLE_TRUTH_VALUE;
+		write_bool(is_simple);
+		if (not is_simple)
+			write_double(tv->get_count());
+	}
+}
+
+void CheckpointWriter::write_rule(const RulePtr& rule)
+{
+	if (not rule) {
+		_out.put(UNDEFINED_TAG);
+		return;
+	}
+
+	auto it = _rule_index.find(rule.get());
+	if (it != _rule_index.end()) {
+		_out.put(REFERENCE_TAG);
+		write_size(it->second);
+		return;
+	}
+
+	_out.put(LINK_TAG);
+	write_handle(rule->get_alias());
+	write_handle(rule->get_rule());
+	write_handle(rule->get_rbs());
+	write_bool(rule->is_exhausted());
+	write_bool(rule->premises_as_clauses);
+	size_t idx = _rule_index.size();
+	_rule_index[rule.get()] = idx;
+}
+
+/////////////////////
+// CheckpointReader //
+/////////////////////
+
+CheckpointReader::CheckpointReader(std::istream& in) : _in(in)
+{
+}
+
+void CheckpointReader::check_stream() const
+{
+	if (not _in)
+		throw RuntimeException(TRACE_INFO,
+			"CheckpointReader - unexpected end of checkpoint");
+}
+
+void CheckpointReader::read_header(char kind)
+{
+	std::string magic(checkpoint_magic.size(), '\0');
+	_in.read(&magic[0], magic.size());
+	check_stream();
+	if (magic != checkpoint_magic)
+		throw RuntimeException(TRACE_INFO,
+			"CheckpointReader - not a URE checkpoint");
+
+	size_t version = read_size();
+	if (version != checkpoint_version)
+		throw RuntimeException(TRACE_INFO,
+			"CheckpointReader - unsupported checkpoint version %zu", version);
+
+	char actual_kind = _in.get();
+	check_stream();
+	if (actual_kind != kind)
+		throw RuntimeException(TRACE_INFO,
+			"CheckpointReader - expected a checkpoint of kind '%c', got '%c'",
+			kind, actual_kind);
+}
+
+bool CheckpointReader::read_bool()
+{
+	int c = _in.get();
+	check_stream();
+	return c != 0;
+}
+
+size_t CheckpointReader::read_size()
+{
+	size_t n = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7) {
+		unsigned char byte = _in.get();
+		check_stream();
+		n |= size_t(byte & 0x7f) << shift;
+		if (not (byte & 0x80))
+			return n;
+	}
+	throw RuntimeException(TRACE_INFO,
+		"CheckpointReader - corrupted checkpoint, size too long");
+}
+
+double CheckpointReader::read_double()
+{
+	unsigned char bytes[8];
+	_in.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+	check_stream();
+	uint64_t bits = 0;
+	for (int i = 0; i < 8; i++)
+		bits |= uint64_t(bytes[i]) << (8 * i);
+	double d;
+	std::memcpy(&d, &bits, sizeof(d));
+	return d;
+}
+
+std::string CheckpointReader::read_string()
+{
+	std::string str(read_size(), '\0');
+	_in.read(&str[0], str.size());
+	check_stream();
+	return str;
+}
+
+Handle CheckpointReader::read_handle(AtomSpace& as)
+{
+	unsigned char tag = _in.get();
+	check_stream();
+
+	if (tag == UNDEFINED_TAG)
+		return Handle::UNDEFINED;
+
+	if (tag == REFERENCE_TAG) {
+		size_t idx = read_size();
+		if (_handles.size() <= idx)
+			throw RuntimeException(TRACE_INFO,
+				"CheckpointReader - invalid atom reference %zu", idx);
+		return as.add_atom(_handles[idx]);
+	}
+
+	std::string type_name = read_string();
+	Type type = nameserver().getType(type_name);
+	if (type == NOTYPE)
+		throw RuntimeException(TRACE_INFO,
+			"CheckpointReader - unknown atom type %s", type_name.c_str());
+
+	Handle h;
+	if (tag == NODE_TAG) {
+		h = as.add_node(type, read_string());
+	} else if (tag == LINK_TAG) {
+		h = as.add_link(type, read_handles(as));
+	} else {
+		throw RuntimeException(TRACE_INFO,
+			"CheckpointReader - invalid atom tag %u", tag);
+	}
+
+	TruthValuePtr tv = read_tv();
+	if (tv and h->getTruthValue()->isDefaultTV())
+		h->setTruthValue(tv);
+
+	_handles.push_back(h);
+	return h;
+}
+
+HandleSeq CheckpointReader::read_handles(AtomSpace& as)
+{
+	size_t size = read_size();
+	HandleSeq hs;
+	hs.reserve(size);
+	for (size_t i = 0; i < size; i++)
+		hs.push_back(read_handle(as));
+	return hs;
+}
+
+TruthValuePtr CheckpointReader::read_tv()
+{
+	if (not read_bool())
+		return nullptr;
+	double mean = read_double();
+	double confidence = read_double();
+	if (read_bool())
+		return SimpleTruthValue::createTV(mean, confidence);
+	double count = read_double();
+	return CountTruthValue::createTV(mean, confidence, count);
+}
+
+RulePtr CheckpointReader::read_rule(AtomSpace& rb_as, AtomSpace& rule_as)
+{
+	unsigned char tag = _in.get();
+	check_stream();
+
+	if (tag == UNDEFINED_TAG)
+		return nullptr;
+
+	if (tag == REFERENCE_TAG) {
+		size_t idx = read_size();
+		if (_rules.size() <= idx)
+			throw RuntimeException(TRACE_INFO,
+				"CheckpointReader - invalid rule reference %zu", idx);
+		return _rules[idx];
+	}
+
+	Handle alias = read_handle(rb_as);
+	Handle rule_h = read_handle(rule_as);
+	Handle rbs = read_handle(rb_as);
+	RulePtr rule = createRule(alias, rule_h, rbs);
+	if (read_bool())
+		rule->set_exhausted();
+	rule->premises_as_clauses = read_bool();
+
+	_rules.push_back(rule);
+	return rule;
+}
@@ -0,0 +1,120 @@
+/*
+ * Checkpoint.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_CHECKPOINT_H_
+#define _OPENCOG_URE_CHECKPOINT_H_
+
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "Rule.h"
+
+namespace opencog
+{
+
+/**
+ * Compact binary encoding of chainer search states, so that they can
+ * be saved and resumed later on, possibly in another process.
+ *
+ * Sizes are encoded as variable length integers, doubles as 64-bit
+ * little endian IEEE doubles, and atoms recursively by type name,
+ * then name or outgoing set, then truth value if not default. Atoms
+ * and rules are only encoded once, subsequent occurrences are encoded
+ * as references to their first occurrence.
+ *
+ * Truth values are encoded by their mean and confidence, and, unless
+ * simple, their count. They are read back as simple truth values, or
+ * as count truth values, thus other kinds of truth values lose their
+ * specific parameters.
+ *
+ * A checkpoint starts with a header made of a magic string, a format
+ * version and a letter indicating the kind of chainer ('F' for the
+ * forward chainer, 'B' for the backward chainer).
+ */
+class CheckpointWriter
+{
+public:
+	CheckpointWriter(std::ostream& out);
+
+	void write_header(char kind);
+	void write_bool(bool b);
+	void write_size(size_t n);
+	void write_double(double d);
+	void write_string(const std::string& str);
+	void write_handle(const Handle& h);
+	void write_handles(const HandleSeq& hs);
+	void write_tv(const TruthValuePtr& tv);
+	void write_rule(const RulePtr& rule);
+
+private:
+	std::ostream& _out;
+
+	// Index of the atoms and rules already written
+	std::unordered_map<Handle, size_t> _handle_index;
+	std::unordered_map<const Rule*, size_t> _rule_index;
+};
+
+class CheckpointReader
+{
+public:
+	CheckpointReader(std::istream& in);
+
+	/**
+	 * Read the header and throw a RuntimeException if it is not a
+	 * valid checkpoint of the given kind.
+	 */
+	void read_header(char kind);
+	bool read_bool();
+	size_t read_size();
+	double read_double();
+	std::string read_string();
+
+	/**
+	 * Read an atom and add it to the given atomspace. If the atom has
+	 * a non default truth value and is not already in the atomspace,
+	 * with a non default truth value, then its truth value is set.
+	 */
+	Handle read_handle(AtomSpace& as);
+	HandleSeq read_handles(AtomSpace& as);
+	TruthValuePtr read_tv();
+
+	/**
+	 * Read a rule. Its alias and rule-base are added to rb_as, and
+	 * its definition, that may be a specialization not present in
+	 * rb_as, to rule_as.
+	 */
+	RulePtr read_rule(AtomSpace& rb_as, AtomSpace& rule_as);
+
+private:
+	std::istream& _in;
+
+	// Atoms and rules already read, in their order of occurrence
+	HandleSeq _handles;
+	std::vector<RulePtr> _rules;
+
+	void check_stream() const;
+};
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_CHECKPOINT_H_ */
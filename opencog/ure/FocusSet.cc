@@ -0,0 +1,153 @@
+/*
+ * FocusSet.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/query/DefaultImplicator.h>
+
+#include "FocusSet.h"
+
+using namespace opencog;
+
+FocusSet::FocusSet()
+{
+}
+
+FocusSet::FocusSet(const HandleSeq& atoms)
+	: _atoms(atoms.begin(), atoms.end())
+{
+}
+
+bool FocusSet::empty() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _atoms.empty();
+}
+
+size_t FocusSet::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _atoms.size();
+}
+
+bool FocusSet::contains(const Handle& h) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _atoms.find(h) != _atoms.end();
+}
+
+void FocusSet::insert(const Handle& h)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_atoms.insert(h);
+}
+
+void FocusSet::insert(const HandleSeq& hs)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_atoms.insert(hs.begin(), hs.end());
+}
+
+void FocusSet::insert(const HandleSet& hs)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_atoms.insert(hs.begin(), hs.end());
+}
+
+HandleSeq FocusSet::get_atoms() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return HandleSeq(_atoms.begin(), _atoms.end());
+}
+
+namespace {
+
+/**
+ * Pattern matcher callback rejecting clause groundings outside the
+ * focus set, so that the search is pruned as soon as a clause is
+ * grounded by an atom not under focus.
+ */
+class FocusSetPMCB : public DefaultImplicator
+{
+public:
+	FocusSetPMCB(AtomSpace* as, const FocusSet& focus_set)
+		: DefaultImplicator(as),
+		  Implicator(as),
+		  InitiateSearchCB(as),
+		  DefaultPatternMatchCB(as),
+		  _focus_set(focus_set) {}
+
+	virtual bool clause_match(const Handle& ptrn, const Handle& grnd,
+	                          const HandleMap& term_gnds)
+	{
+		return _focus_set.contains(grnd) and
+			DefaultPatternMatchCB::clause_match(ptrn, grnd, term_gnds);
+	}
+
+private:
+	const FocusSet& _focus_set;
+};
+
+} // ~namespace
+
+HandleSeq FocusSet::execute(const Handle& bindlink, AtomSpace& as) const
+{
+	BindLinkPtr bl = BindLinkCast(bindlink);
+
+	// Fully grounded, it only needs to be checked against the focus
+	// set before being executed.
+	if (bl->get_variables().varseq.empty()) {
+		if (not is_focused(bl->get_body(), as))
+			return {};
+		return HandleCast(bl->execute(&as))->getOutgoingSet();
+	}
+
+	// Otherwise let the pattern matcher reject groundings outside the
+	// focus set as it searches.
+	FocusSetPMCB fs_pmcb(&as, *this);
+	fs_pmcb.implicand = bl->get_implicand();
+	bl->satisfy(fs_pmcb);
+	return fs_pmcb.get_result_list();
+}
+
+bool FocusSet::is_focused(const Handle& body, const AtomSpace& as) const
+{
+	auto focused = [&](const Handle& clause) { return is_focused(clause, as); };
+	Type t = body->get_type();
+
+	// A conjunction needs all its clauses under focus
+	if (t == AND_LINK or t == PRESENT_LINK) {
+		const HandleSeq& clauses = body->getOutgoingSet();
+		return std::all_of(clauses.begin(), clauses.end(), focused);
+	}
+
+	// A disjunction only needs one of them
+	if (t == OR_LINK) {
+		const HandleSeq& clauses = body->getOutgoingSet();
+		return std::any_of(clauses.begin(), clauses.end(), focused);
+	}
+
+	// Clauses absent from the atomspace, such as virtual ones, are
+	// not subject to the focus.
+	Handle h = as.get_atom(body);
+	return not h or contains(h);
+}
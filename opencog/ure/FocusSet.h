@@ -0,0 +1,98 @@
+/*
+ * FocusSet.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_FOCUSSET_H_
+#define _OPENCOG_URE_FOCUSSET_H_
+
+#include <mutex>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atoms/pattern/BindLink.h>
+
+namespace opencog
+{
+
+/**
+ * Set of atoms under focus, held as a membership filter over the
+ * atomspace they belong to, rather than copied into a dedicated
+ * atomspace. Chaining restricted to a focus set only considers
+ * groundings of rule premises, or forward chaining strategy clauses,
+ * that belong to it. The products are meant to be inserted as they
+ * are obtained, so that subsequent inferences can build on them.
+ *
+ * Insertions and lookups can be done concurrently.
+ */
+class FocusSet
+{
+public:
+	FocusSet();
+	FocusSet(const HandleSeq& atoms);
+
+	bool empty() const;
+	size_t size() const;
+
+	/**
+	 * Return true iff h is under focus.
+	 */
+	bool contains(const Handle& h) const;
+
+	/**
+	 * Put atoms under focus
+	 */
+	void insert(const Handle& h);
+	void insert(const HandleSeq& hs);
+	void insert(const HandleSet& hs);
+
+	/**
+	 * Return the atoms under focus, in no particular order.
+	 */
+	HandleSeq get_atoms() const;
+
+	/**
+	 * Execute the given BindLink over as, only considering its
+	 * groundings such that all clauses present in as are under
+	 * focus. Return the results of its rewrite terms, not
+	 * necessarily added to as.
+	 *
+	 * Groundings are restricted by the pattern matcher itself, which
+	 * abandons a search branch as soon as one of its clauses is
+	 * grounded by an atom not under focus.
+	 */
+	HandleSeq execute(const Handle& bindlink, AtomSpace& as) const;
+
+private:
+	/**
+	 * Return true iff all clauses of the given grounded pattern body
+	 * present in as are under focus, or, for a disjunction, any of
+	 * them is.
+	 */
+	bool is_focused(const Handle& body, const AtomSpace& as) const;
+
+	HandleSet _atoms;
+	mutable std::mutex _mutex;
+};
+
+typedef std::shared_ptr<FocusSet> FocusSetPtr;
+#define createFocusSet std::make_shared<FocusSet>
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_FOCUSSET_H_ */
@@ -35,8 +35,28 @@
 
 using namespace opencog;
 
+MixtureModel::ModelStats MixtureModel::model_stats(const Handle& model)
+{
+	ModelStats stats;
+	stats.tv = model->getTruthValue();
+	stats.length = get_all_uniq_atoms(model).size();
+	stats.count = stats.tv->get_count();
+	BetaDistribution beta_dist(stats.tv);
+	stats.beta_factor = boost::math::beta(beta_dist.alpha(), beta_dist.beta());
+	stats.mean = beta_dist.mean();
+	stats.variance = beta_dist.variance();
+	return stats;
+}
+
 MixtureModel::MixtureModel(const HandleSet& mds, double cpx, double cmp) :
-	models(mds), cpx_penalty(cpx), compressiveness(cmp)
+	models(mds), cpx_penalty(cpx), compressiveness(cmp), _stats(nullptr)
+{
+	data_set_size = infer_data_set_size();
+}
+
+MixtureModel::MixtureModel(const HandleSet& mds, const ModelStatsMap& stats,
+                           double cpx, double cmp) :
+	models(mds), cpx_penalty(cpx), compressiveness(cmp), _stats(&stats)
 {
 	data_set_size = infer_data_set_size();
 }
@@ -47,20 +67,35 @@ TruthValuePtr MixtureModel::operator()() const
 	if (models.size() == 1)
 		return (*models.begin())->getTruthValue();
 
-	std::vector<TruthValuePtr> tvs;
-	std::vector<double> weights;
+	std::vector<double> means, variances, weights;
 	for (const Handle& model : models) {
-		double weight = prior_estimate(model) * beta_factor(model);
+		ModelStats stats = get_stats(model);
+		double weight = prior_estimate(stats) * stats.beta_factor;
 		LAZY_URE_LOG_FINE << "MixtureModel::operator model = " << model->id_to_string()
 		                  << ", weight = " << weight;
-		tvs.push_back(model->getTruthValue());
+		means.push_back(stats.mean);
+		variances.push_back(stats.variance);
 		weights.push_back(weight);
 	}
-	return weighted_average(tvs, weights);
+	return weighted_average(means, variances, weights);
 }
 
 TruthValuePtr MixtureModel::weighted_average(const std::vector<TruthValuePtr>& tvs,
                                              const std::vector<double>& weights) const
+{
+	// Calculate the TV means and variances
+	std::vector<double> means, variances;
+	for (const TruthValuePtr& tv : tvs) {
+		BetaDistribution bd(tv);
+		means.push_back(bd.mean());
+		variances.push_back(bd.variance());
+	}
+	return weighted_average(means, variances, weights);
+}
+
+TruthValuePtr MixtureModel::weighted_average(const std::vector<double>& means,
+                                             const std::vector<double>& variances,
+                                             const std::vector<double>& weights) const
 {
 	// Normalize the weights
 	double total = boost::accumulate(weights, 0.0);
@@ -68,15 +103,6 @@ TruthValuePtr MixtureModel::weighted_average(const std::vector<TruthValuePtr>& t
 	boost::transform(weights, std::back_inserter(norm_weights),
 	                 [total](double w) { return w / total; });
 
-	// Calculate the TV means and variances
-	std::vector<BetaDistribution> dists;
-	std::vector<double> means, variances;
-	boost::transform(tvs, std::back_inserter(dists), mk_beta_distribution);
-	boost::transform(dists, std::back_inserter(means),
-	                 [](const BetaDistribution& bd) { return bd.mean(); });
-	boost::transform(tvs, std::back_inserter(variances),
-	                 [](const BetaDistribution& bd) { return bd.variance(); });
-
 	// For now the mixed TV remains a SimpleTV, thus a
 	// beta-distribution. The mean and variance is calculated
 	// according to
@@ -95,8 +121,7 @@ TruthValuePtr MixtureModel::weighted_average(const std::vector<TruthValuePtr>& t
 
 double MixtureModel::beta_factor(const Handle& model) const
 {
-	BetaDistribution beta_dist(model->getTruthValue());
-	double factor = boost::math::beta(beta_dist.alpha(), beta_dist.beta());
+	double factor = get_stats(model).beta_factor;
 	LAZY_URE_LOG_FINE << "MixtureModel::beta_factor factor = " << factor;
 	return factor;
 }
@@ -104,10 +129,13 @@ double MixtureModel::beta_factor(const Handle& model) const
 double MixtureModel::prior_estimate(const Handle& model) const
 {
 	LAZY_URE_LOG_FINE << "MixtureModel::prior_estimate model = " << model->id_to_string();
+	return prior_estimate(get_stats(model));
+}
 
-	HandleSet all_atoms(get_all_uniq_atoms(model));
-	double partial_length = all_atoms.size(),
-		remain_data_size = data_set_size - model->getTruthValue()->get_count(),
+double MixtureModel::prior_estimate(const ModelStats& stats) const
+{
+	double partial_length = stats.length,
+		remain_data_size = data_set_size - stats.count,
 		kestimate = kolmogorov_estimate(remain_data_size);
 
 	LAZY_URE_LOG_FINE << "MixtureModel::prior_estimate "
@@ -131,10 +159,27 @@ double MixtureModel::prior(double length) const
 	return pri;
 }
 
+const MixtureModel::ModelStats* MixtureModel::find_stats(const Handle& model) const
+{
+	if (not _stats)
+		return nullptr;
+	auto it = _stats->find(model);
+	return it != _stats->end() ? &it->second : nullptr;
+}
+
+MixtureModel::ModelStats MixtureModel::get_stats(const Handle& model) const
+{
+	const ModelStats* stats = find_stats(model);
+	return stats ? *stats : model_stats(model);
+}
+
 double MixtureModel::infer_data_set_size() const
 {
 	double max_count = 0.0;
-	for (const Handle& model : models)
-		max_count = std::max(max_count, model->getTruthValue()->get_count());
+	for (const Handle& model : models) {
+		const ModelStats* stats = find_stats(model);
+		double count = stats ? stats->count : model->getTruthValue()->get_count();
+		max_count = std::max(max_count, count);
+	}
 	return max_count;
 }
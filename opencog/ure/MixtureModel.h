@@ -23,6 +23,8 @@
 #ifndef _OPENCOG_MIXTUREMODEL_H_
 #define _OPENCOG_MIXTUREMODEL_H_
 
+#include <unordered_map>
+
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
 
@@ -39,6 +41,33 @@ namespace opencog
 class MixtureModel
 {
 public:
+	// Statistics of a model that do not depend on the mixture, so
+	// that they can be calculated once for models that are
+	// repeatedly mixed, such as control rules.
+	struct ModelStats
+	{
+		TruthValuePtr tv;
+
+		// Number of unique atoms of the model, see prior_estimate
+		double length;
+
+		// Count of the model TV
+		double count;
+
+		// Beta(alpha, beta) of the model TV, see beta_factor
+		double beta_factor;
+
+		// Mean and variance of the beta-distribution of the model TV
+		double mean;
+		double variance;
+	};
+	typedef std::unordered_map<Handle, ModelStats> ModelStatsMap;
+
+	/**
+	 * Calculate the statistics of the given model
+	 */
+	static ModelStats model_stats(const Handle& model);
+
 	// Set of active models. Active means that they fulfill the
 	// preconditions of the data to explain.
 	HandleSet models;
@@ -70,6 +99,16 @@ public:
 	             double cpx_penalty=1.0,
 	             double compressiveness=0.0);
 
+	/**
+	 * Like above, but take the statistics of the models from stats
+	 * rather than calculating them, if there. stats must outlive the
+	 * mixture model.
+	 */
+	MixtureModel(const HandleSet& models,
+	             const ModelStatsMap& stats,
+	             double cpx_penalty=1.0,
+	             double compressiveness=0.0);
+
 	/**
 	 * Calculate the TV of the mixture model. Assuming the ith model,
 	 * Mi, with prior Pi, has its TV represented by a probabilistic
@@ -118,6 +157,13 @@ public:
 	TruthValuePtr weighted_average(const std::vector<TruthValuePtr>& tvs,
 	                               const std::vector<double>& weights) const;
 
+	/**
+	 * Like above, but given the means and variances of the TVs.
+	 */
+	TruthValuePtr weighted_average(const std::vector<double>& means,
+	                               const std::vector<double>& variances,
+	                               const std::vector<double>& weights) const;
+
 	/**
 	 * Calculate the alpha and beta parameters of the model's TV, and
 	 * return Beta(alpha, beta), where Beta is the beta function.
@@ -160,6 +206,27 @@ public:
 	double prior(double length) const;
 
 private:
+	// Precomputed statistics of the models, if any
+	const ModelStatsMap* _stats;
+
+	/**
+	 * Return the precomputed statistics of the given model, nullptr
+	 * if none.
+	 */
+	const ModelStats* find_stats(const Handle& model) const;
+
+	/**
+	 * Return the statistics of the given model, from _stats if
+	 * there, calculated otherwise.
+	 */
+	ModelStats get_stats(const Handle& model) const;
+
+	/**
+	 * Calculate the prior estimate of a model given its statistics,
+	 * see prior_estimate.
+	 */
+	double prior_estimate(const ModelStats& stats) const;
+
 	/**
 	 * Infer the data set size by taking the max count of all models
 	 * (it works assuming that one of them is complete).
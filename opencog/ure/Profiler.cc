@@ -0,0 +1,222 @@
+/*
+ * Profiler.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <opencog/util/oc_assert.h>
+
+#include "Profiler.h"
+
+using namespace opencog;
+
+static const uint64_t no_min = std::numeric_limits<uint64_t>::max();
+
+double Profiler::PhaseStats::mean_ns() const
+{
+	return count == 0 ? 0.0 : (double)total_ns / count;
+}
+
+uint64_t Profiler::PhaseStats::quantile_ns(double q) const
+{
+	if (count == 0)
+		return 0;
+	uint64_t rank = std::max<uint64_t>(1, std::ceil(q * count));
+	uint64_t cumul = 0;
+	for (size_t i = 0; i < histogram.size(); i++) {
+		cumul += histogram[i];
+		if (rank <= cumul)
+			return std::min(max_ns, (uint64_t(1) << (i + 1)) - 1);
+	}
+	return max_ns;
+}
+
+Profiler::Profiler(bool enabled) : _enabled(enabled), _active(enabled)
+{
+	reset();
+}
+
+Profiler::Profiler(const Profiler& other)
+	: _enabled(other._enabled), _active(other._active)
+{
+	operator=(other);
+}
+
+Profiler& Profiler::operator=(const Profiler& other)
+{
+	if (this == &other)
+		return *this;
+	_enabled = other._enabled;
+	_timeline = other._timeline;
+	_active = other._active;
+	for (size_t p = 0; p < PHASE_COUNT; p++) {
+		const AtomicPhaseStats& ops = other._stats[p];
+		AtomicPhaseStats& ps = _stats[p];
+		ps.count = ops.count.load();
+		ps.total_ns = ops.total_ns.load();
+		ps.min_ns = ops.min_ns.load();
+		ps.max_ns = ops.max_ns.load();
+		for (size_t i = 0; i < histogram_size; i++)
+			ps.histogram[i] = ops.histogram[i].load();
+	}
+	return *this;
+}
+
+void Profiler::set_enabled(bool enabled)
+{
+	_enabled = enabled;
+	_active = _enabled or _timeline;
+}
+
+void Profiler::set_timeline(const TimelinePtr& timeline)
+{
+	_timeline = timeline;
+	_active = _enabled or _timeline;
+}
+
+const TimelinePtr& Profiler::get_timeline() const
+{
+	return _timeline;
+}
+
+void Profiler::record(Phase phase, clock::time_point start,
+                      clock::time_point end, int iteration)
+{
+	if (_timeline)
+		_timeline->record(phase_name(phase), phase_category(phase),
+		                  start, end, iteration);
+	if (_enabled) {
+		auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+		record(phase, std::max<int64_t>(0, d.count()));
+	}
+}
+
+void Profiler::record(Phase phase, uint64_t ns)
+{
+	OC_ASSERT(phase < PHASE_COUNT);
+	static const auto relaxed = std::memory_order_relaxed;
+	AtomicPhaseStats& ps = _stats[phase];
+
+	ps.count.fetch_add(1, relaxed);
+	ps.total_ns.fetch_add(ns, relaxed);
+
+	uint64_t min = ps.min_ns.load(relaxed);
+	while (ns < min and not ps.min_ns.compare_exchange_weak(min, ns, relaxed));
+	uint64_t max = ps.max_ns.load(relaxed);
+	while (max < ns and not ps.max_ns.compare_exchange_weak(max, ns, relaxed));
+
+	// Index of the most significant bit of ns, that is floor(log2(ns))
+	size_t bucket = 0;
+	for (uint64_t v = ns >> 1; v != 0 and bucket + 1 < histogram_size; v >>= 1)
+		bucket++;
+	ps.histogram[bucket].fetch_add(1, relaxed);
+}
+
+Profiler::PhaseStats Profiler::get_stats(Phase phase) const
+{
+	OC_ASSERT(phase < PHASE_COUNT);
+	const AtomicPhaseStats& ps = _stats[phase];
+	PhaseStats stats;
+	stats.count = ps.count.load();
+	stats.total_ns = ps.total_ns.load();
+	stats.min_ns = stats.count == 0 ? 0 : ps.min_ns.load();
+	stats.max_ns = ps.max_ns.load();
+	for (const std::atomic<uint64_t>& bucket : ps.histogram)
+		stats.histogram.push_back(bucket.load());
+	return stats;
+}
+
+void Profiler::reset()
+{
+	for (AtomicPhaseStats& ps : _stats) {
+		ps.count = 0;
+		ps.total_ns = 0;
+		ps.min_ns = no_min;
+		ps.max_ns = 0;
+		for (std::atomic<uint64_t>& bucket : ps.histogram)
+			bucket = 0;
+	}
+}
+
+const char* Profiler::phase_name(Phase phase)
+{
+	switch (phase) {
+	case FC_ITERATION: return "iteration";
+	case FC_SELECT_SOURCE: return "select_source";
+	case FC_GET_VALID_RULES: return "get_valid_rules";
+	case FC_UNIFICATION: return "unification";
+	case FC_APPLY_RULE: return "apply_rule";
+	case FC_SOURCE_SET_INSERT: return "source_set_insert";
+	case FC_STAT: return "fc_stat";
+	case FC_PART_MUTEX_WAIT: return "part_mutex_wait";
+	case FC_RULES_MUTEX_WAIT: return "rules_mutex_wait";
+	case FC_SOURCE_INSERT_RULE: return "source_insert_rule";
+	case BC_ITERATION: return "iteration";
+	case BC_SELECT_EXPANSION_ANDBIT: return "select_expansion_andbit";
+	case BC_SELECT_LEAF: return "select_leaf";
+	case BC_SELECT_RULE: return "select_rule";
+	case BC_EXPAND_FCS: return "expand_fcs";
+	case BC_FULFILL_FCS: return "fulfill_fcs";
+	case BC_REDUCE_BIT: return "reduce_bit";
+	default: return "unknown";
+	}
+}
+
+const char* Profiler::phase_category(Phase phase)
+{
+	return phase < BC_ITERATION ? "fc" : "bc";
+}
+
+std::string Profiler::to_string(const std::string& indent) const
+{
+	// Latencies are displayed in microseconds
+	auto us = [](double ns) { return ns / 1000.0; };
+
+	std::stringstream ss;
+	ss << indent << std::left << std::setw(24) << "phase" << std::right
+	   << std::setw(10) << "count" << std::setw(14) << "total (us)"
+	   << std::setw(12) << "mean (us)" << std::setw(12) << "p50 (us)"
+	   << std::setw(12) << "p99 (us)" << std::setw(12) << "max (us)";
+	ss << std::fixed << std::setprecision(1);
+	for (size_t p = 0; p < PHASE_COUNT; p++) {
+		PhaseStats stats = get_stats((Phase)p);
+		if (stats.count == 0)
+			continue;
+		ss << std::endl << indent
+		   << std::left << std::setw(24) << phase_name((Phase)p) << std::right
+		   << std::setw(10) << stats.count
+		   << std::setw(14) << us(stats.total_ns)
+		   << std::setw(12) << us(stats.mean_ns())
+		   << std::setw(12) << us(stats.quantile_ns(0.5))
+		   << std::setw(12) << us(stats.quantile_ns(0.99))
+		   << std::setw(12) << us(stats.max_ns);
+	}
+	return ss.str();
+}
+
+std::string opencog::oc_to_string(const Profiler& profiler,
+                                  const std::string& indent)
+{
+	return profiler.to_string(indent);
+}
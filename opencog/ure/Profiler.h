@@ -0,0 +1,242 @@
+/*
+ * Profiler.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_PROFILER_H_
+#define _OPENCOG_URE_PROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opencog/util/empty_string.h>
+
+#include "Timeline.h"
+
+namespace opencog
+{
+
+/**
+ * Count and time the phases of a chainer, recording for each phase
+ * its number of calls, total, minimum and maximum latencies, as well
+ * as a latency histogram.
+ *
+ * Profiling is disabled by default, in which case timing a phase
+ * merely amounts to testing a flag, so that it costs nothing
+ * measurable. It can be enabled with the URE:profile parameter of the
+ * rule-based system, or programmatically before chaining. Recording
+ * is thread safe, so that a profiler can be shared by all the jobs of
+ * a chainer.
+ *
+ * Additionally, if a timeline is attached, each timed phase is
+ * recorded in it as an event, regardless of whether profiling is
+ * enabled.
+ */
+class Profiler
+{
+public:
+	typedef std::chrono::steady_clock clock;
+
+	/**
+	 * Phases of the forward and backward chainers
+	 */
+	enum Phase
+	{
+		// Forward chainer
+		FC_ITERATION,           // ForwardChainer::do_step
+		FC_SELECT_SOURCE,       // ForwardChainer::select_source
+		FC_GET_VALID_RULES,     // ForwardChainer::get_valid_rules
+		FC_UNIFICATION,         // Rule::unify_source in get_valid_rules
+		FC_APPLY_RULE,          // ForwardChainer::apply_rule
+		FC_SOURCE_SET_INSERT,   // SourceSet::insert
+		FC_STAT,                // FCStat::add_inference_record
+		FC_PART_MUTEX_WAIT,     // Waiting for ForwardChainer::_part_mutex
+		FC_RULES_MUTEX_WAIT,    // Waiting for ForwardChainer::_rules_mutex
+		FC_SOURCE_INSERT_RULE,  // Source::insert_rule, mostly waiting
+		                        // for Source::_mutex under contention
+
+		// Backward chainer
+		BC_ITERATION,           // BackwardChainer::do_step
+		BC_SELECT_EXPANSION_ANDBIT, // BackwardChainer::select_expansion_andbit
+		BC_SELECT_LEAF,         // AndBIT::select_leaf
+		BC_SELECT_RULE,         // ControlPolicy::select_rule
+		BC_EXPAND_FCS,          // BIT::expand, dominated by AndBIT::expand_fcs
+		BC_FULFILL_FCS,         // BackwardChainer::fulfill_fcs
+		BC_REDUCE_BIT,          // BackwardChainer::reduce_bit
+
+		PHASE_COUNT
+	};
+
+	/**
+	 * Number of buckets of the latency histograms. Bucket i counts
+	 * the latencies within [2^i, 2^(i+1)) nanoseconds, except the
+	 * first one which also counts null latencies and the last one
+	 * which counts all latencies above 2^i.
+	 */
+	static const size_t histogram_size = 40;
+
+	/**
+	 * Snapshot of the statistics of a phase
+	 */
+	struct PhaseStats
+	{
+		uint64_t count;
+		uint64_t total_ns;
+		uint64_t min_ns;        // 0 if count is 0
+		uint64_t max_ns;
+		std::vector<uint64_t> histogram;
+
+		double mean_ns() const;
+
+		/**
+		 * Return an upper bound of the q-quantile of the latencies,
+		 * with q within [0, 1], as estimated from the histogram.
+		 */
+		uint64_t quantile_ns(double q) const;
+	};
+
+	/**
+	 * Time a phase from construction to destruction, or to stop if
+	 * called before. Does nothing if the profiler is disabled and has
+	 * no timeline. The iteration, if non-negative, is attached to the
+	 * timeline event.
+	 */
+	class Timer
+	{
+	public:
+		Timer(Profiler& profiler, Phase phase, int iteration=-1)
+			: _profiler(profiler.is_active() ? &profiler : nullptr),
+			  _phase(phase), _iteration(iteration)
+		{
+			if (_profiler)
+				_start = clock::now();
+		}
+
+		~Timer()
+		{
+			stop();
+		}
+
+		void stop()
+		{
+			if (_profiler) {
+				_profiler->record(_phase, _start, clock::now(), _iteration);
+				_profiler = nullptr;
+			}
+		}
+
+	private:
+		Profiler* _profiler;
+		Phase _phase;
+		int _iteration;
+		clock::time_point _start;
+	};
+
+	Profiler(bool enabled=false);
+
+	// Copy a snapshot of the statistics of another profiler
+	Profiler(const Profiler& other);
+	Profiler& operator=(const Profiler& other);
+
+	/**
+	 * Enable or disable profiling. Must not be called while chaining.
+	 */
+	void set_enabled(bool enabled);
+	bool is_enabled() const
+	{
+		return _enabled;
+	}
+
+	/**
+	 * Attach a timeline where to record the timed phases, or detach
+	 * it if null. Must not be called while chaining.
+	 */
+	void set_timeline(const TimelinePtr& timeline);
+	const TimelinePtr& get_timeline() const;
+
+	/**
+	 * Return true iff profiling is enabled or a timeline is attached
+	 */
+	bool is_active() const
+	{
+		return _active;
+	}
+
+	/**
+	 * Record a call of the given phase, started at start and ended at
+	 * end, in the statistics if enabled, and in the timeline if any.
+	 */
+	void record(Phase phase, clock::time_point start, clock::time_point end,
+	            int iteration=-1);
+	void record(Phase phase, uint64_t ns);
+
+	/**
+	 * Return the statistics of the given phase
+	 */
+	PhaseStats get_stats(Phase phase) const;
+
+	/**
+	 * Reset the statistics of all phases
+	 */
+	void reset();
+
+	/**
+	 * Return the name of the given phase, such as "select_source".
+	 */
+	static const char* phase_name(Phase phase);
+
+	/**
+	 * Return "fc" or "bc" depending on the chainer of the given phase
+	 */
+	static const char* phase_category(Phase phase);
+
+	/**
+	 * Return a table of the statistics of the phases that have been
+	 * called at least once.
+	 */
+	std::string to_string(const std::string& indent=empty_string) const;
+
+private:
+	struct AtomicPhaseStats
+	{
+		std::atomic<uint64_t> count;
+		std::atomic<uint64_t> total_ns;
+		std::atomic<uint64_t> min_ns;
+		std::atomic<uint64_t> max_ns;
+		std::array<std::atomic<uint64_t>, histogram_size> histogram;
+	};
+
+	bool _enabled;
+	TimelinePtr _timeline;
+
+	// Equal to _enabled or _timeline, so that a timer tests one flag
+	bool _active;
+
+	std::array<AtomicPhaseStats, PHASE_COUNT> _stats;
+};
+
+std::string oc_to_string(const Profiler& profiler,
+                         const std::string& indent=empty_string);
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_PROFILER_H_ */
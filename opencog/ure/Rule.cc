@@ -71,7 +71,7 @@ void RuleSet::expand_meta_rules(AtomSpace& as)
 				createRule(rule->get_alias(), produced_h, rule->get_rbs());
 			auto [_, ir] = insert(produced);
 			if (ir) {
-				ure_logger().debug() << "New rule instantiated from a meta rule:"
+				LAZY_URE_LOG_DEBUG << "New rule instantiated from a meta rule:"
 											<< std::endl << oc_to_string(*produced);
 			}
 		}
@@ -41,10 +41,11 @@ std::vector<double> ThompsonSampling::distribution() const
 {
 	std::vector<double> probs(_tvs.size());
 
-	// Calculate cdfs for all TVs
+	// Calculate cdfs for all TVs. Action TVs tend to repeat across
+	// calls so they are memoized.
 	std::vector<std::vector<double>> cdfs;
 	for (const auto& tv : _tvs)
-		cdfs.push_back(BetaDistribution(tv).cdf(_bins));
+		cdfs.push_back(memo_cdf(tv, _bins));
 
 	// Calculate Pi for all actions
 	// where Pi = I_0^1 pdfi(x) Prod_j!=i cdfj(x) dx
@@ -0,0 +1,159 @@
+/*
+ * Timeline.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+
+#include <opencog/util/exceptions.h>
+
+#include "Timeline.h"
+
+using namespace opencog;
+
+static std::atomic<unsigned long> timeline_count(0);
+
+// Write a string as a JSON string
+static void write_json_string(std::ostream& out, const char* str)
+{
+	out << '"';
+	for (const char* c = str; *c; c++) {
+		if (*c == '"' or *c == '\\')
+			out << '\\' << *c;
+		else if ((unsigned char)*c < 0x20)
+			out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+			    << (int)*c << std::dec << std::setfill(' ');
+		else
+			out << *c;
+	}
+	out << '"';
+}
+
+Timeline::Timeline(const std::string& filename)
+	: _id(++timeline_count), _filename(filename), _origin(clock::now())
+{
+}
+
+void Timeline::record(const char* name, const char* cat,
+                      clock::time_point start, clock::time_point end,
+                      int iteration)
+{
+	thread_buffer().events.push_back({name, cat, start, end, iteration});
+}
+
+Timeline::ThreadBuffer& Timeline::thread_buffer()
+{
+	// Buffer of the calling thread for the last timeline it has
+	// recorded into, so that the mutex is only taken once per thread
+	// and timeline.
+	thread_local unsigned long cached_id = 0;
+	thread_local ThreadBuffer* cached_buffer = nullptr;
+	if (cached_id == _id)
+		return *cached_buffer;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::thread::id thread_id = std::this_thread::get_id();
+	auto it = _thread2buffer.find(thread_id);
+	if (it == _thread2buffer.end()) {
+		_buffers.push_back({(int)_buffers.size() + 1, {}});
+		it = _thread2buffer.emplace(thread_id, &_buffers.back()).first;
+	}
+	cached_id = _id;
+	cached_buffer = it->second;
+	return *cached_buffer;
+}
+
+size_t Timeline::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	size_t s = 0;
+	for (const ThreadBuffer& buffer : _buffers)
+		s += buffer.events.size();
+	return s;
+}
+
+size_t Timeline::threads() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _buffers.size();
+}
+
+void Timeline::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (ThreadBuffer& buffer : _buffers)
+		buffer.events.clear();
+}
+
+const std::string& Timeline::get_filename() const
+{
+	return _filename;
+}
+
+void Timeline::write(std::ostream& out) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	// Timestamps and durations are in microseconds
+	auto us = [](clock::duration d) {
+		return std::chrono::duration<double, std::micro>(d).count();
+	};
+
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	out << std::fixed << std::setprecision(3);
+	bool first = true;
+	for (const ThreadBuffer& buffer : _buffers) {
+		// Name the thread
+		out << (first ? "" : ",") << std::endl
+		    << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+		    << buffer.tid << ",\"args\":{\"name\":\"thread "
+		    << buffer.tid << "\"}}";
+		first = false;
+
+		for (const Event& event : buffer.events) {
+			out << "," << std::endl << "{\"name\":";
+			write_json_string(out, event.name);
+			out << ",\"cat\":";
+			write_json_string(out, event.cat);
+			out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.tid
+			    << ",\"ts\":" << us(event.start - _origin)
+			    << ",\"dur\":" << us(event.end - event.start);
+			if (0 <= event.iteration)
+				out << ",\"args\":{\"iteration\":" << event.iteration << "}";
+			out << "}";
+		}
+	}
+	out << std::endl << "]}" << std::endl;
+}
+
+void Timeline::write(const std::string& filename) const
+{
+	std::ofstream out(filename);
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"Timeline - cannot open %s", filename.c_str());
+	write(out);
+}
+
+void Timeline::write() const
+{
+	write(_filename);
+}
@@ -0,0 +1,137 @@
+/*
+ * Timeline.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_TIMELINE_H_
+#define _OPENCOG_URE_TIMELINE_H_
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencog/util/empty_string.h>
+
+namespace opencog
+{
+
+/**
+ * Record timed events, such as chainer iterations and phases, per
+ * thread, to be written as a Chrome trace-event JSON file, viewable
+ * with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Events are buffered in memory, in a buffer per thread, so that
+ * recording does not contend between threads, and written at the end
+ * of chaining. Each event is written as a complete event, that is a
+ * begin/end pair.
+ *
+ * A timeline is attached to a chainer via its profiler, see
+ * Profiler::set_timeline.
+ */
+class Timeline
+{
+public:
+	typedef std::chrono::steady_clock clock;
+
+	/**
+	 * @param filename  File where the events are written at the end
+	 *                  of chaining, if not empty.
+	 */
+	Timeline(const std::string& filename=empty_string);
+
+	/**
+	 * Record in the buffer of the calling thread an event named name,
+	 * of category cat, that started at start and ended at end. The
+	 * iteration, if non-negative, is attached to the event. name and
+	 * cat must outlive the timeline, typically string literals.
+	 */
+	void record(const char* name, const char* cat,
+	            clock::time_point start, clock::time_point end,
+	            int iteration=-1);
+
+	/**
+	 * Number of events, and number of threads, recorded so far. Must
+	 * not be called while recording.
+	 */
+	size_t size() const;
+	size_t threads() const;
+
+	/**
+	 * Remove all events recorded so far
+	 */
+	void clear();
+
+	const std::string& get_filename() const;
+
+	/**
+	 * Write the events in Chrome trace-event JSON format, to the given
+	 * stream or file, or to the file given at construction. Must not
+	 * be called while recording. Throw a RuntimeException if the file
+	 * cannot be written.
+	 */
+	void write(std::ostream& out) const;
+	void write(const std::string& filename) const;
+	void write() const;
+
+private:
+	struct Event
+	{
+		const char* name;
+		const char* cat;
+		clock::time_point start;
+		clock::time_point end;
+		int iteration;
+	};
+
+	struct ThreadBuffer
+	{
+		int tid;
+		std::vector<Event> events;
+	};
+
+	// Return the buffer of the calling thread, creating it if needed
+	ThreadBuffer& thread_buffer();
+
+	// Identify the timeline, so that threads can cache their buffer
+	// without risking to reuse the one of a destroyed timeline.
+	const unsigned long _id;
+
+	const std::string _filename;
+
+	// Timestamps are relative to that time point
+	const clock::time_point _origin;
+
+	mutable std::mutex _mutex;
+
+	// Buffers, never removed so that references remain valid
+	std::deque<ThreadBuffer> _buffers;
+	std::map<std::thread::id, ThreadBuffer*> _thread2buffer;
+};
+
+typedef std::shared_ptr<Timeline> TimelinePtr;
+#define createTimeline std::make_shared<Timeline>
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_TIMELINE_H_ */
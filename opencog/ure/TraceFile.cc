@@ -0,0 +1,545 @@
+/*
+ * TraceFile.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+
+#include "TraceFile.h"
+#include "URELogger.h"
+#include "backwardchainer/TraceRecorder.h"
+#include "forwardchainer/FCStat.h"
+
+using namespace opencog;
+
+static const char trace_magic[] = "URETRACE";
+static const size_t trace_magic_size = sizeof(trace_magic) - 1;
+
+const uint32_t TraceWriter::version = 2;
+const size_t TraceWriter::buffer_size = 1 << 16;
+
+// Minimum number of written atoms remembered before pruning the freed
+// ones, so that small traces are never pruned.
+static const size_t min_prune_size = 1 << 12;
+
+TraceWriter::TraceWriter(const std::string& filename)
+	: _filename(filename),
+	  _file(filename, std::ios::binary | std::ios::trunc),
+	  _size(0), _closed(false), _failed(false),
+	  _atoms_count(0), _prune_size(min_prune_size)
+{
+	if (not _file)
+		throw RuntimeException(TRACE_INFO,
+			"TraceWriter - cannot open %s", filename.c_str());
+
+	_buffer.reserve(buffer_size);
+	_buffer.append(trace_magic, trace_magic_size);
+	for (int i = 0; i < 4; i++)
+		put_byte((version >> (8 * i)) & 0xff);
+
+	_thread = std::thread(&TraceWriter::write_loop, this);
+}
+
+TraceWriter::~TraceWriter()
+{
+	try {
+		close();
+	} catch (const RuntimeException& ex) {
+		ure_logger().error() << ex.get_message();
+	}
+}
+
+void TraceWriter::target(const Handle& target)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_closed)
+		return;
+	uint64_t id = put_atom(target);
+	put_byte((uint8_t)TraceTag::TARGET);
+	put_varint(id);
+	flush_if_full();
+}
+
+void TraceWriter::andbit(const Handle& fcs)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_closed)
+		return;
+	uint64_t id = put_atom(fcs);
+	put_byte((uint8_t)TraceTag::ANDBIT);
+	put_varint(id);
+	flush_if_full();
+}
+
+void TraceWriter::expansion(const Handle& andbit_fcs,
+                            const Handle& bitleaf_body,
+                            const Handle& rule_alias,
+                            const Handle& new_andbit_fcs)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_closed)
+		return;
+	uint64_t ids[] = {put_atom(andbit_fcs), put_atom(bitleaf_body),
+	                  put_atom(rule_alias), put_atom(new_andbit_fcs)};
+	put_byte((uint8_t)TraceTag::EXPANSION);
+	for (uint64_t id : ids)
+		put_varint(id);
+	flush_if_full();
+}
+
+void TraceWriter::proof(const Handle& andbit_fcs, const Handle& target_result)
+{
+	TruthValuePtr tv = target_result->getTruthValue();
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_closed)
+		return;
+	uint64_t fcs_id = put_atom(andbit_fcs);
+	uint64_t result_id = put_atom(target_result);
+	put_byte((uint8_t)TraceTag::PROOF);
+	put_varint(fcs_id);
+	put_varint(result_id);
+	put_double(tv->get_mean());
+	put_double(tv->get_confidence());
+	flush_if_full();
+}
+
+void TraceWriter::inference(unsigned iteration, const Handle& source,
+                            const Handle& rule_alias,
+                            const HandleSet& product)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_closed)
+		return;
+	uint64_t source_id = put_atom(source);
+	uint64_t rule_id = put_atom(rule_alias);
+	std::vector<uint64_t> product_ids;
+	product_ids.reserve(product.size());
+	for (const Handle& h : product)
+		product_ids.push_back(put_atom(h));
+	put_byte((uint8_t)TraceTag::INFERENCE);
+	put_varint(iteration);
+	put_varint(source_id);
+	put_varint(rule_id);
+	put_varint(product_ids.size());
+	for (uint64_t id : product_ids)
+		put_varint(id);
+	flush_if_full();
+}
+
+void TraceWriter::close()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_closed)
+			return;
+		put_byte((uint8_t)TraceTag::END);
+		_queue.push_back(std::move(_buffer));
+		_buffer.clear();
+		_closed = true;
+	}
+	_cv.notify_one();
+	_thread.join();
+	_file.close();
+
+	if (_failed or _file.fail())
+		throw RuntimeException(TRACE_INFO,
+			"TraceWriter::close - failed to write %s", _filename.c_str());
+}
+
+const std::string& TraceWriter::get_filename() const
+{
+	return _filename;
+}
+
+size_t TraceWriter::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _size;
+}
+
+void TraceWriter::put_byte(uint8_t b)
+{
+	_buffer.push_back((char)b);
+	_size++;
+}
+
+void TraceWriter::put_varint(uint64_t x)
+{
+	while (0x80 <= x) {
+		put_byte((x & 0x7f) | 0x80);
+		x >>= 7;
+	}
+	put_byte(x);
+}
+
+void TraceWriter::put_uint64(uint64_t x)
+{
+	for (int i = 0; i < 8; i++)
+		put_byte((x >> (8 * i)) & 0xff);
+}
+
+void TraceWriter::put_double(double x)
+{
+	uint64_t bits;
+	std::memcpy(&bits, &x, sizeof(bits));
+	put_uint64(bits);
+}
+
+void TraceWriter::put_string(const std::string& str)
+{
+	put_varint(str.size());
+	_buffer.append(str);
+	_size += str.size();
+}
+
+void TraceWriter::define_type(Type type)
+{
+	if (not _types.insert(type).second)
+		return;
+	put_byte((uint8_t)TraceTag::TYPE);
+	put_varint(type);
+	put_string(nameserver().getTypeName(type));
+}
+
+uint64_t TraceWriter::put_atom(const Handle& h)
+{
+	ContentHash hash = h->get_hash();
+	auto range = _atoms.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it) {
+		Handle written(it->second.atom.lock());
+		if (written and (written.get() == h.get() or content_eq(written, h)))
+			return it->second.id;
+	}
+
+	Type type = h->get_type();
+	if (h->is_node()) {
+		define_type(type);
+		put_byte((uint8_t)TraceTag::NODE);
+		put_varint(type);
+		put_string(h->get_name());
+	} else {
+		// Outgoing atoms are defined before the link
+		std::vector<uint64_t> outgoing;
+		outgoing.reserve(h->get_arity());
+		for (const Handle& child : h->getOutgoingSet())
+			outgoing.push_back(put_atom(child));
+		define_type(type);
+		put_byte((uint8_t)TraceTag::LINK);
+		put_varint(type);
+		put_varint(outgoing.size());
+		for (uint64_t child_id : outgoing)
+			put_varint(child_id);
+	}
+
+	// The id of an atom is the number of atoms defined before it
+	uint64_t id = _atoms_count++;
+	_atoms.emplace(hash, WrittenAtom{h, id});
+	if (_prune_size <= _atoms.size())
+		prune_atoms();
+	return id;
+}
+
+void TraceWriter::prune_atoms()
+{
+	for (auto it = _atoms.begin(); it != _atoms.end();) {
+		if (it->second.atom.expired())
+			it = _atoms.erase(it);
+		else
+			++it;
+	}
+
+	// Prune again once the number of remembered atoms has doubled,
+	// so that pruning is amortized over the atoms written.
+	_prune_size = std::max(min_prune_size, 2 * _atoms.size());
+}
+
+void TraceWriter::flush_if_full()
+{
+	if (_buffer.size() < buffer_size)
+		return;
+	_queue.push_back(std::move(_buffer));
+	_buffer.clear();
+	_buffer.reserve(buffer_size);
+	_cv.notify_one();
+}
+
+void TraceWriter::write_loop()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true) {
+		_cv.wait(lock, [&]() { return _closed or not _queue.empty(); });
+		if (_queue.empty())
+			return;
+		std::string buffer = std::move(_queue.front());
+		_queue.pop_front();
+
+		// Write without holding the lock so that recording goes on
+		lock.unlock();
+		_file.write(buffer.data(), buffer.size());
+		bool failed = _file.fail();
+		lock.lock();
+		if (failed and not _failed) {
+			_failed = true;
+			ure_logger().error() << "TraceWriter - failed to write "
+			                     << _filename;
+		}
+	}
+}
+
+TraceReader::TraceReader(const std::string& filename)
+	: _filename(filename), _file(filename, std::ios::binary),
+	  _complete(false)
+{
+	if (not _file)
+		throw RuntimeException(TRACE_INFO,
+			"TraceReader - cannot open %s", filename.c_str());
+
+	char magic[trace_magic_size];
+	_file.read(magic, trace_magic_size);
+	if (not _file or std::memcmp(magic, trace_magic, trace_magic_size) != 0)
+		throw RuntimeException(TRACE_INFO,
+			"TraceReader - %s is not a trace file", filename.c_str());
+
+	uint32_t version = 0;
+	for (int i = 0; i < 4; i++) {
+		uint8_t b;
+		if (not get_byte(b))
+			throw RuntimeException(TRACE_INFO,
+				"TraceReader - %s is not a trace file", filename.c_str());
+		version |= (uint32_t)b << (8 * i);
+	}
+	if (version != TraceWriter::version)
+		throw RuntimeException(TRACE_INFO,
+			"TraceReader - unsupported version %u of %s",
+			version, filename.c_str());
+}
+
+bool TraceReader::next(TraceEvent& event)
+{
+	uint8_t tag;
+	while (get_byte(tag)) {
+		event.tag = (TraceTag)tag;
+		event.atoms.clear();
+		switch (event.tag) {
+		case TraceTag::TYPE: {
+			uint64_t code;
+			std::string name;
+			if (not get_varint(code) or not get_string(name))
+				return false;
+			Type type = nameserver().getType(name);
+			if (type == NOTYPE)
+				throw RuntimeException(TRACE_INFO,
+					"TraceReader - unknown type %s in %s",
+					name.c_str(), _filename.c_str());
+			_types[code] = type;
+			break;
+		}
+		case TraceTag::NODE: {
+			AtomRecord record;
+			if (not get_type(record.type) or not get_string(record.name))
+				return false;
+			_atoms.push_back(std::move(record));
+			break;
+		}
+		case TraceTag::LINK: {
+			uint64_t arity;
+			AtomRecord record;
+			if (not get_type(record.type) or not get_varint(arity)
+			    or not get_ids(arity, record.outgoing))
+				return false;
+			for (uint64_t child_id : record.outgoing)
+				if (_atoms.size() <= child_id)
+					throw RuntimeException(TRACE_INFO,
+						"TraceReader - corrupted trace %s, undefined atom %lu",
+						_filename.c_str(), (unsigned long)child_id);
+			_atoms.push_back(std::move(record));
+			break;
+		}
+		case TraceTag::TARGET:
+		case TraceTag::ANDBIT:
+			return get_ids(1, event.atoms);
+		case TraceTag::EXPANSION:
+			return get_ids(4, event.atoms);
+		case TraceTag::PROOF:
+			return get_ids(2, event.atoms) and get_double(event.strength)
+				and get_double(event.confidence);
+		case TraceTag::INFERENCE: {
+			uint64_t iteration, size;
+			if (not get_varint(iteration) or not get_ids(2, event.atoms)
+			    or not get_varint(size) or not get_ids(size, event.atoms))
+				return false;
+			event.iteration = iteration;
+			return true;
+		}
+		case TraceTag::END:
+			_complete = true;
+			return false;
+		default:
+			throw RuntimeException(TRACE_INFO,
+				"TraceReader - corrupted trace %s, unknown tag %u",
+				_filename.c_str(), (unsigned)tag);
+		}
+	}
+	return false;
+}
+
+bool TraceReader::complete() const
+{
+	return _complete;
+}
+
+Handle TraceReader::get_atom(uint64_t id, AtomSpace& as) const
+{
+	if (_atoms.size() <= id)
+		throw RuntimeException(TRACE_INFO,
+			"TraceReader - corrupted trace %s, undefined atom %lu",
+			_filename.c_str(), (unsigned long)id);
+
+	const AtomRecord& record = _atoms[id];
+	if (nameserver().isNode(record.type))
+		return as.add_node(record.type, std::string(record.name));
+
+	HandleSeq outgoing;
+	outgoing.reserve(record.outgoing.size());
+	for (uint64_t child_id : record.outgoing)
+		outgoing.push_back(get_atom(child_id, as));
+	return as.add_link(record.type, std::move(outgoing));
+}
+
+bool TraceReader::get_byte(uint8_t& b)
+{
+	char c;
+	if (not _file.get(c))
+		return false;
+	b = (uint8_t)c;
+	return true;
+}
+
+bool TraceReader::get_varint(uint64_t& x)
+{
+	x = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		uint8_t b;
+		if (not get_byte(b))
+			return false;
+		x |= (uint64_t)(b & 0x7f) << shift;
+		if (not (b & 0x80))
+			return true;
+	}
+	throw RuntimeException(TRACE_INFO,
+		"TraceReader - corrupted trace %s, varint too long",
+		_filename.c_str());
+}
+
+bool TraceReader::get_uint64(uint64_t& x)
+{
+	x = 0;
+	for (int i = 0; i < 8; i++) {
+		uint8_t b;
+		if (not get_byte(b))
+			return false;
+		x |= (uint64_t)b << (8 * i);
+	}
+	return true;
+}
+
+bool TraceReader::get_double(double& x)
+{
+	uint64_t bits;
+	if (not get_uint64(bits))
+		return false;
+	std::memcpy(&x, &bits, sizeof(x));
+	return true;
+}
+
+bool TraceReader::get_string(std::string& str)
+{
+	uint64_t size;
+	if (not get_varint(size))
+		return false;
+	str.resize(size);
+	_file.read(&str[0], size);
+	return (bool)_file;
+}
+
+bool TraceReader::get_type(Type& type)
+{
+	uint64_t code;
+	if (not get_varint(code))
+		return false;
+	auto it = _types.find(code);
+	if (it == _types.end())
+		throw RuntimeException(TRACE_INFO,
+			"TraceReader - corrupted trace %s, undefined type %lu",
+			_filename.c_str(), (unsigned long)code);
+	type = it->second;
+	return true;
+}
+
+bool TraceReader::get_ids(size_t n, std::vector<uint64_t>& ids)
+{
+	for (size_t i = 0; i < n; i++) {
+		uint64_t id;
+		if (not get_varint(id))
+			return false;
+		ids.push_back(id);
+	}
+	return true;
+}
+
+bool opencog::load_trace(const std::string& filename, AtomSpace& trace_as)
+{
+	TraceReader reader(filename);
+	TraceRecorder recorder(&trace_as);
+	TraceEvent event;
+	while (reader.next(event)) {
+		HandleSeq atoms;
+		for (uint64_t id : event.atoms)
+			atoms.push_back(reader.get_atom(id, trace_as));
+
+		switch (event.tag) {
+		case TraceTag::TARGET:
+			recorder.target(atoms[0]);
+			break;
+		case TraceTag::ANDBIT:
+			recorder.andbit(atoms[0]);
+			break;
+		case TraceTag::EXPANSION:
+			recorder.expansion(atoms[0], atoms[1], atoms[2], atoms[3]);
+			break;
+		case TraceTag::PROOF:
+			atoms[1]->setTruthValue(
+				SimpleTruthValue::createTV(event.strength, event.confidence));
+			recorder.proof(atoms[0], atoms[1]);
+			break;
+		case TraceTag::INFERENCE:
+			FCStat::trace(&trace_as, event.iteration, atoms[0], atoms[1],
+			              HandleSet(std::next(atoms.begin(), 2), atoms.end()));
+			break;
+		default:
+			break;
+		}
+	}
+	return reader.complete();
+}
@@ -0,0 +1,285 @@
+/*
+ * TraceFile.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_TRACEFILE_H_
+#define _OPENCOG_URE_TRACEFILE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+
+/**
+ * Compact append-only binary format of the inference traces, an
+ * alternative to recording them in a trace atomspace (see
+ * TraceRecorder and FCStat) that does not hold the traced atoms in
+ * memory.
+ *
+ * A trace file starts with the magic "URETRACE" followed by the
+ * version as a 32-bit little endian integer, then a stream of
+ * records, each starting with its tag as a byte. Atoms are defined by
+ * an atom record the first time they appear, before the records
+ * referring to them, and identified by the number of atoms defined
+ * before them, so that ids are unique. As the writer does not keep
+ * the traced atoms alive, an atom freed then created again is defined
+ * again under a new id. Atom types are likewise
+ * defined by name the first time they appear, so that traces do not
+ * depend on the type numbering of the process that wrote them.
+ * Integers, including ids, are unsigned LEB128 varints, strings are
+ * prefixed by their length, and reals are 64-bit little endian IEEE
+ * doubles.
+ *
+ * TYPE       <type> <name>
+ * NODE       <type> <name>
+ * LINK       <type> <arity> <id>...
+ * TARGET     <target>
+ * ANDBIT     <fcs>
+ * EXPANSION  <andbit fcs> <bitleaf body> <rule alias> <new andbit fcs>
+ * PROOF      <andbit fcs> <target result> <strength> <confidence>
+ * INFERENCE  <iteration> <source> <rule alias> <size> <product>...
+ * END
+ *
+ * The END record is written when the trace is closed, a trace
+ * without it has been interrupted.
+ */
+enum class TraceTag : uint8_t
+{
+	TYPE = 1,
+	NODE,
+	LINK,
+	TARGET,
+	ANDBIT,
+	EXPANSION,
+	PROOF,
+	INFERENCE,
+	END = 0xff
+};
+
+/**
+ * Event of a trace, as read by TraceReader. atoms holds the ids of
+ * the atoms of the event, in the order of its record, see TraceTag.
+ */
+struct TraceEvent
+{
+	TraceTag tag;
+	std::vector<uint64_t> atoms;
+
+	// INFERENCE only
+	unsigned iteration = 0;
+
+	// PROOF only, TV of the target result
+	double strength = 0;
+	double confidence = 0;
+};
+
+/**
+ * Write inference traces to a file. Events are encoded by the calling
+ * thread into a memory buffer, which, once full, is handed to a
+ * background thread writing it to the file, so that inference never
+ * waits on the disk. Events may be recorded concurrently.
+ */
+class TraceWriter
+{
+public:
+	static const uint32_t version;
+
+	// Size of the memory buffer handed to the background thread
+	static const size_t buffer_size;
+
+	/**
+	 * Open filename for writing, truncating it. Throw a
+	 * RuntimeException if it cannot be opened.
+	 */
+	TraceWriter(const std::string& filename);
+
+	/**
+	 * Close the trace if it has not been already
+	 */
+	~TraceWriter();
+
+	// Backward chainer events, see TraceRecorder
+	void target(const Handle& target);
+	void andbit(const Handle& fcs);
+	void expansion(const Handle& andbit_fcs, const Handle& bitleaf_body,
+	               const Handle& rule_alias, const Handle& new_andbit_fcs);
+	void proof(const Handle& andbit_fcs, const Handle& target_result);
+
+	// Forward chainer event, see FCStat
+	void inference(unsigned iteration, const Handle& source,
+	               const Handle& rule_alias, const HandleSet& product);
+
+	/**
+	 * Write the END record, wait until everything has been written
+	 * and close the file. Events recorded afterwards are ignored.
+	 * Throw a RuntimeException if the file could not be fully
+	 * written.
+	 */
+	void close();
+
+	const std::string& get_filename() const;
+
+	/**
+	 * Number of bytes recorded so far, written or not yet
+	 */
+	size_t size() const;
+
+private:
+	// Encoding helpers, to be called while holding _mutex
+	void put_byte(uint8_t b);
+	void put_varint(uint64_t x);
+	void put_uint64(uint64_t x);
+	void put_double(double x);
+	void put_string(const std::string& str);
+
+	// Write the TYPE record of type, if not written already
+	void define_type(Type type);
+
+	// Write the records of h and its outgoing atoms, if not written
+	// already, then return its id.
+	uint64_t put_atom(const Handle& h);
+
+	// Forget the written atoms that have been freed since
+	void prune_atoms();
+
+	// Hand the buffer to the background thread if full
+	void flush_if_full();
+
+	// Background thread loop
+	void write_loop();
+
+	const std::string _filename;
+	std::ofstream _file;
+
+	mutable std::mutex _mutex;
+	std::condition_variable _cv;
+
+	// Buffer being encoded into, and full buffers to be written
+	std::string _buffer;
+	std::deque<std::string> _queue;
+	size_t _size;
+	bool _closed;
+	bool _failed;
+
+	// Types already written
+	std::unordered_set<Type> _types;
+
+	// Atoms already written, by content hash, with their ids. They are
+	// weakly referred to, so that tracing does not keep them alive,
+	// and forgotten once freed, see prune_atoms.
+	struct WrittenAtom
+	{
+		std::weak_ptr<Atom> atom;
+		uint64_t id;
+	};
+	std::unordered_multimap<ContentHash, WrittenAtom> _atoms;
+
+	// Number of atoms defined so far, that is the id of the next one
+	uint64_t _atoms_count;
+
+	// Size of _atoms above which it is pruned next
+	size_t _prune_size;
+
+	std::thread _thread;
+};
+
+typedef std::shared_ptr<TraceWriter> TraceWriterPtr;
+#define createTraceWriter std::make_shared<TraceWriter>
+
+/**
+ * Read inference traces from a file written by TraceWriter.
+ */
+class TraceReader
+{
+public:
+	/**
+	 * Open filename for reading. Throw a RuntimeException if it
+	 * cannot be opened or is not a trace file of a supported
+	 * version.
+	 */
+	TraceReader(const std::string& filename);
+
+	/**
+	 * Read the next event into event, also reading the types and
+	 * atoms it refers to. Return false at the end of the trace, or if
+	 * it ends with an incomplete record, such as when the writer has
+	 * been interrupted. Throw a RuntimeException if the trace is
+	 * corrupted.
+	 */
+	bool next(TraceEvent& event);
+
+	/**
+	 * Whether the END record has been read
+	 */
+	bool complete() const;
+
+	/**
+	 * Add to as the atom of the given id, read so far. Throw a
+	 * RuntimeException if there is no such atom.
+	 */
+	Handle get_atom(uint64_t id, AtomSpace& as) const;
+
+private:
+	struct AtomRecord
+	{
+		Type type;
+		std::string name;
+		std::vector<uint64_t> outgoing;
+	};
+
+	// Decoding helpers, return false at the end of the file
+	bool get_byte(uint8_t& b);
+	bool get_varint(uint64_t& x);
+	bool get_uint64(uint64_t& x);
+	bool get_double(double& x);
+	bool get_string(std::string& str);
+	bool get_type(Type& type);
+	bool get_ids(size_t n, std::vector<uint64_t>& ids);
+
+	const std::string _filename;
+	std::ifstream _file;
+	bool _complete;
+
+	// Types read so far, and atoms read so far indexed by id
+	std::unordered_map<uint64_t, Type> _types;
+	std::vector<AtomRecord> _atoms;
+};
+
+/**
+ * Convert the trace of filename back to atomese, as TraceRecorder
+ * and FCStat would have recorded it in trace_as. Return whether the
+ * trace is complete, see TraceReader::complete.
+ */
+bool load_trace(const std::string& filename, AtomSpace& trace_as);
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_TRACEFILE_H_ */
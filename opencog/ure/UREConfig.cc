@@ -41,6 +41,14 @@ const std::string UREConfig::jobs_name =
 	"URE:jobs";
 const std::string UREConfig::expansion_pool_size_name =
 	"URE:expansion-pool-size";
+const std::string UREConfig::max_time_name =
+	"URE:maximum-time";
+const std::string UREConfig::max_cpu_time_name =
+	"URE:maximum-cpu-time";
+const std::string UREConfig::max_atoms_added_name =
+	"URE:maximum-atoms-added";
+const std::string UREConfig::profile_name =
+	"URE:profile";
 const std::string UREConfig::fc_retry_exhausted_sources_name =
 	"URE:FC:retry-exhausted-sources";
 const std::string UREConfig::fc_full_rule_application_name =
@@ -51,6 +59,8 @@ const std::string UREConfig::bc_mm_complexity_penalty_name =
 	"URE:BC:MM:complexity-penalty";
 const std::string UREConfig::bc_mm_compressiveness_name =
 	"URE:BC:MM:compressiveness";
+const std::string UREConfig::bc_max_bit_atoms_name =
+	"URE:BC:maximum-bit-atoms";
 
 UREConfig::UREConfig(AtomSpace& as, const Handle& rbs) : _as(as)
 {
@@ -58,9 +68,24 @@ UREConfig::UREConfig(AtomSpace& as, const Handle& rbs) : _as(as)
 		throw RuntimeException(TRACE_INFO,
 			"UREConfig - invalid rulebase specified!");
 
-	fetch_common_parameters(rbs);
-	fetch_fc_parameters(rbs);
-	fetch_bc_parameters(rbs);
+	fetch_rules(rbs);
+	fetch_parameters(rbs);
+}
+
+UREConfig::UREConfig(const UREConfig& other)
+	: _as(other._as),
+	  _common_params(other._common_params),
+	  _fc_params(other._fc_params),
+	  _bc_params(other._bc_params)
+{
+	RuleSet& rules = _common_params.rules;
+	for (RulePtr& rule : rules)
+		rule = createRule(*rule);
+}
+
+AtomSpace& UREConfig::get_atomspace() const
+{
+	return _as;
 }
 
 const RuleSet& UREConfig::get_rules() const
@@ -93,6 +118,26 @@ int UREConfig::get_expansion_pool_size() const
 	return _common_params.expansion_pool_size;
 }
 
+double UREConfig::get_maximum_time() const
+{
+	return _common_params.max_time;
+}
+
+double UREConfig::get_maximum_cpu_time() const
+{
+	return _common_params.max_cpu_time;
+}
+
+double UREConfig::get_maximum_atoms_added() const
+{
+	return _common_params.max_atoms_added;
+}
+
+bool UREConfig::get_profile() const
+{
+	return _common_params.profile;
+}
+
 bool UREConfig::get_retry_exhausted_sources() const
 {
 	return _fc_params.retry_exhausted_sources;
@@ -118,6 +163,11 @@ double UREConfig::get_mm_compressiveness() const
 	return _bc_params.mm_compressiveness;
 }
 
+double UREConfig::get_max_bit_atoms() const
+{
+	return _bc_params.max_bit_atoms;
+}
+
 std::string UREConfig::get_maximum_iterations_str() const
 {
 	if (_common_params.max_iter < 0)
@@ -145,6 +195,26 @@ void UREConfig::set_expansion_pool_size(int eps)
 	_common_params.expansion_pool_size = eps;
 }
 
+void UREConfig::set_maximum_time(double mt)
+{
+	_common_params.max_time = mt;
+}
+
+void UREConfig::set_maximum_cpu_time(double mct)
+{
+	_common_params.max_cpu_time = mct;
+}
+
+void UREConfig::set_maximum_atoms_added(double maa)
+{
+	_common_params.max_atoms_added = maa;
+}
+
+void UREConfig::set_profile(bool p)
+{
+	_common_params.profile = p;
+}
+
 void UREConfig::set_retry_exhausted_sources(bool rs)
 {
 	_fc_params.retry_exhausted_sources = rs;
@@ -155,6 +225,11 @@ void UREConfig::set_full_rule_application(bool rs)
 	_fc_params.full_rule_application = rs;
 }
 
+void UREConfig::set_max_bit_size(double mbs)
+{
+	_bc_params.max_bit_size = mbs;
+}
+
 void UREConfig::set_mm_complexity_penalty(double mm_cp)
 {
 	_bc_params.mm_complexity_penalty = mm_cp;
@@ -165,6 +240,11 @@ void UREConfig::set_mm_compressiveness(double mm_cpr)
 	_bc_params.mm_complexity_penalty = mm_cpr;
 }
 
+void UREConfig::set_max_bit_atoms(double mba)
+{
+	_bc_params.max_bit_atoms = mba;
+}
+
 HandleSeq UREConfig::fetch_rule_names(const Handle& rbs)
 {
 	// Retrieve rules
@@ -182,7 +262,14 @@ HandleSeq UREConfig::fetch_rule_names(const Handle& rbs)
 	return rule_names;
 }
 
-void UREConfig::fetch_common_parameters(const Handle& rbs)
+void UREConfig::fetch_parameters(const Handle& rbs)
+{
+	fetch_common_parameters(rbs);
+	fetch_fc_parameters(rbs);
+	fetch_bc_parameters(rbs);
+}
+
+void UREConfig::fetch_rules(const Handle& rbs)
 {
 	// Retrieve the rules (MemberLinks) and instantiate them
 	for (const Handle& rule_name : fetch_rule_names(rbs))
@@ -195,7 +282,10 @@ void UREConfig::fetch_common_parameters(const Handle& rbs)
 
 		_common_params.rules.insert(createRule(rule_name, rbs));
 	}
+}
 
+void UREConfig::fetch_common_parameters(const Handle& rbs)
+{
 	// Fetch maximum number of iterations
 	_common_params.max_iter = fetch_num_param(max_iter_name, rbs, 100);
 
@@ -209,6 +299,17 @@ void UREConfig::fetch_common_parameters(const Handle& rbs)
 	// Fetch production application ratio
 	_common_params.expansion_pool_size =
 		fetch_num_param(expansion_pool_size_name, rbs, 1);
+
+	// Fetch time budgets
+	_common_params.max_time = fetch_num_param(max_time_name, rbs, -1);
+	_common_params.max_cpu_time = fetch_num_param(max_cpu_time_name, rbs, -1);
+
+	// Fetch maximum number of atoms added
+	_common_params.max_atoms_added =
+		fetch_num_param(max_atoms_added_name, rbs, -1);
+
+	// Fetch profiling parameter
+	_common_params.profile = fetch_bool_param(profile_name, rbs, false);
 }
 
 void UREConfig::fetch_fc_parameters(const Handle& rbs)
@@ -232,6 +333,9 @@ void UREConfig::fetch_bc_parameters(const Handle& rbs)
 	// Fetch BC Mixture Model compressiveness parameter
 	_bc_params.mm_compressiveness =
 		fetch_num_param(bc_mm_compressiveness_name, rbs, 1);
+
+	// Fetch BC BIT atomspace maximum size parameter
+	_bc_params.max_bit_atoms = fetch_num_param(bc_max_bit_atoms_name, rbs, -1);
 }
 
 HandleSeq UREConfig::fetch_execution_outputs(const Handle& schema,
@@ -53,10 +53,18 @@ public:
 	// rbs is a Handle pointing to a rule-based system is as
 	UREConfig(AtomSpace& as, const Handle& rbs);
 
+	// Copy the parameters without querying the AtomSpace again. Rules
+	// are copied as well, as they keep track of the state of the
+	// chainer using them (exhausted flags, etc).
+	UREConfig(const UREConfig& other);
+
 	///////////////
 	// Accessors //
 	///////////////
 
+	// Rule-base atomspace
+	AtomSpace& get_atomspace() const;
+
 	// Common
 	const RuleSet& get_rules() const;
 	RuleSet& get_rules();
@@ -64,6 +72,10 @@ public:
 	double get_complexity_penalty() const;
 	int get_jobs() const;
 	int get_expansion_pool_size() const;
+	double get_maximum_time() const;
+	double get_maximum_cpu_time() const;
+	double get_maximum_atoms_added() const;
+	bool get_profile() const;
 	// FC
 	bool get_retry_exhausted_sources() const;
 	bool get_full_rule_application() const;
@@ -71,6 +83,7 @@ public:
 	double get_max_bit_size() const;
 	double get_mm_complexity_penalty() const;
 	double get_mm_compressiveness() const;
+	double get_max_bit_atoms() const;
 
 	// Display
 	std::string get_maximum_iterations_str() const; // "+inf" if negative
@@ -85,12 +98,23 @@ public:
 	void set_complexity_penalty(double);
 	void set_jobs(int);
 	void set_expansion_pool_size(int);
+	void set_maximum_time(double);
+	void set_maximum_cpu_time(double);
+	void set_maximum_atoms_added(double);
+	void set_profile(bool);
 	// FC
 	void set_retry_exhausted_sources(bool);
 	void set_full_rule_application(bool);
 	// BC
+	void set_max_bit_size(double);
 	void set_mm_complexity_penalty(double);
 	void set_mm_compressiveness(double);
+	void set_max_bit_atoms(double);
+
+	// Fetch the parameters of the rule-based system rbs from the
+	// AtomSpace again, overwriting the ones set above, but leaving
+	// the rules untouched.
+	void fetch_parameters(const Handle& rbs);
 
 	//////////////////
 	// Constants    //
@@ -114,6 +138,20 @@ public:
 	// Name of the production application ratio parameter
 	static const std::string expansion_pool_size_name;
 
+	// Name of the maximum wall-clock time (in seconds) parameter
+	static const std::string max_time_name;
+
+	// Name of the maximum CPU time (in seconds) parameter
+	static const std::string max_cpu_time_name;
+
+	// Name of the maximum number of atoms added to the atomspace
+	// parameter
+	static const std::string max_atoms_added_name;
+
+	// Name of the PredicateNode outputting whether the phases of the
+	// chainer should be profiled
+	static const std::string profile_name;
+
 	// Name of the PredicateNode outputting whether sources should be
 	// retried after exhaustion
 	static const std::string fc_retry_exhausted_sources_name;
@@ -134,6 +172,10 @@ public:
 	// much unexplained data are compressed
 	static const std::string bc_mm_compressiveness_name;
 
+	// Name of the maximum number of atoms in the BIT atomspace
+	// parameter
+	static const std::string bc_max_bit_atoms_name;
+
 private:
 	AtomSpace& _as;
 
@@ -160,6 +202,21 @@ private:
 		// iterative forward chainer), but also then the selection is
 		// more costly. Negative means unlimited.
 		int expansion_pool_size;
+
+		// Wall-clock time, in seconds, after which reasoning
+		// terminates. Negative means unlimited.
+		double max_time;
+
+		// CPU time spent in the steps of the chainer, in seconds,
+		// after which reasoning terminates. Negative means unlimited.
+		double max_cpu_time;
+
+		// Number of distinct results produced by the chainer after
+		// which reasoning terminates. Negative means unlimited.
+		double max_atoms_added;
+
+		// Count and time the phases of the chainer, see Profiler.
+		bool profile;
 	};
 	CommonParameters _common_params;
 
@@ -191,6 +248,11 @@ private:
 		// unexplained data are compressed. The compressed unexplained
 		// data are added to the model complexity.
 		double mm_compressiveness;
+
+		// This put an upper boundary on the number of atoms the BIT
+		// atomspace can hold, after which reasoning terminates.
+		// Negative means unlimited.
+		double max_bit_atoms;
 	};
 	BCParameters _bc_params;
 
@@ -202,6 +264,10 @@ private:
 	//    <rbs>
 	HandleSeq fetch_rule_names(const Handle& rbs);
 
+	// Fetch from the atomspace and instantiate all rules of a given
+	// rule-based system
+	void fetch_rules(const Handle& rbs);
+
 	// Fetch from the atomspace all parameters common to the forward
 	// and backward chainer
 	void fetch_common_parameters(const Handle& rbs);
@@ -264,10 +330,10 @@ private:
 	                     const std::string& param_name,
 	                     const T& value, bool is_default=false) const
 	{
-		ure_logger().debug() << "Rule-base " << rbs_input->get_name()
-		                     << ", set parameter " << param_name
-		                     << " to " << value
-		                     << (is_default ? " [default]" : "");
+		LAZY_URE_LOG_DEBUG << "Rule-base " << rbs_input->get_name()
+		                   << ", set parameter " << param_name
+		                   << " to " << value
+		                   << (is_default ? " [default]" : "");
 	}
 };
 
@@ -32,12 +32,27 @@ namespace opencog
 // singleton instance (following Meyer's design pattern)
 Logger& ure_logger();
 
+// Most verbose level of the log statements compiled in. Statements
+// of more verbose levels are compiled out, their stream is never
+// evaluated regardless of the log level at runtime. For instance
+// production builds can pass -DURE_LOG_MAX_LEVEL=opencog::Logger::WARN
+// (see the URE_LOG_MAX_LEVEL cmake variable).
+#ifndef URE_LOG_MAX_LEVEL
+#define URE_LOG_MAX_LEVEL opencog::Logger::FINE
+#endif
+
+// Whether log statements of the given level are compiled in and
+// enabled at runtime.
+#define URE_LOG_ENABLED(LEVEL) \
+	(opencog::Logger::LEVEL <= URE_LOG_MAX_LEVEL and \
+	 ure_logger().is_enabled(opencog::Logger::LEVEL))
+
 // Macros to not evaluate the stream if log level is disabled
-#define LAZY_URE_LOG_ERROR if(ure_logger().is_error_enabled()) ure_logger().error()
-#define LAZY_URE_LOG_WARN if(ure_logger().is_warn_enabled()) ure_logger().warn()
-#define LAZY_URE_LOG_INFO if(ure_logger().is_info_enabled()) ure_logger().info()
-#define LAZY_URE_LOG_DEBUG if(ure_logger().is_debug_enabled()) ure_logger().debug()
-#define LAZY_URE_LOG_FINE if(ure_logger().is_fine_enabled()) ure_logger().fine()
+#define LAZY_URE_LOG_ERROR if(URE_LOG_ENABLED(ERROR)) ure_logger().error()
+#define LAZY_URE_LOG_WARN if(URE_LOG_ENABLED(WARN)) ure_logger().warn()
+#define LAZY_URE_LOG_INFO if(URE_LOG_ENABLED(INFO)) ure_logger().info()
+#define LAZY_URE_LOG_DEBUG if(URE_LOG_ENABLED(DEBUG)) ure_logger().debug()
+#define LAZY_URE_LOG_FINE if(URE_LOG_ENABLED(FINE)) ure_logger().fine()
 
 } // ~namespace opencog
 
@@ -23,7 +23,12 @@
 
 #ifdef HAVE_GUILE
 
+#include <map>
+#include <mutex>
+
+#include <opencog/ure/Profiler.h>
 #include <opencog/ure/URELogger.h>
+#include <opencog/ure/URESession.h>
 #include <opencog/guile/SchemeModule.h>
 
 namespace opencog {
@@ -45,6 +50,19 @@ protected:
 	 *                     chaining will be applied.  If the set link is
 	 *                     empty, chaining will be invoked on the entire
 	 *                     atomspace.
+	 * @param on_result    Schema executed over each new result, or an
+	 *                     empty ListLink if none.
+	 * @param stop_when    Predicate evaluated over each new result,
+	 *                     chaining stops as soon as it is true, or an
+	 *                     empty ListLink if none.
+	 * @param cancel_name  Atom naming the chaining so that it can be
+	 *                     cancelled with cog-ure-cancel, or an empty
+	 *                     ListLink if none.
+	 * @param trace_file   File where to write the inference traces in
+	 *                     binary format, or the empty string if none.
+	 * @param fetch_parameters Whether parameters have been passed, in
+	 *                     which case they are fetched again if a session
+	 *                     is open over rbs.
 	 *
 	 * @return             A SetLink containing the results of FC inference.
 	 */
@@ -53,7 +71,12 @@ protected:
 	                           Handle vardecl,
 	                           bool trace_enabled,
 	                           AtomSpace *trace_as,
-	                           Handle focus_set);
+	                           Handle focus_set,
+	                           Handle on_result,
+	                           Handle stop_when,
+	                           Handle cancel_name,
+	                           const std::string& trace_file,
+	                           bool fetch_parameters);
 
 	/**
 	 * The scheme (cog-mandatory-args-bc) function calls this, to
@@ -68,6 +91,19 @@ protected:
 	 *                     chaining will be applied.  If the set link is
 	 *                     empty, chaining will be invoked on the entire
 	 *                     atomspace.
+	 * @param on_result    Schema executed over each new result, or an
+	 *                     empty ListLink if none.
+	 * @param stop_when    Predicate evaluated over each new result,
+	 *                     chaining stops as soon as it is true, or an
+	 *                     empty ListLink if none.
+	 * @param cancel_name  Atom naming the chaining so that it can be
+	 *                     cancelled with cog-ure-cancel, or an empty
+	 *                     ListLink if none.
+	 * @param trace_file   File where to write the back-inference traces
+	 *                     in binary format, or the empty string if none.
+	 * @param fetch_parameters Whether parameters have been passed, in
+	 *                     which case they are fetched again if a session
+	 *                     is open over rbs.
 	 *
 	 * @return             A SetLink containing the results of FC inference.
 	 */
@@ -78,7 +114,75 @@ protected:
 	                            AtomSpace* trace_as,
 	                            bool control_enabled,
 	                            AtomSpace* control_as,
-	                            Handle focus_set);
+	                            Handle focus_set,
+	                            Handle on_result,
+	                            Handle stop_when,
+	                            Handle cancel_name,
+	                            const std::string& trace_file,
+	                            bool fetch_parameters);
+
+	/**
+	 * The scheme (cog-ure-cancel) function calls this, to cancel the
+	 * chaining named by the given atom.
+	 *
+	 * @return             True if such chaining is running, false
+	 *                     otherwise.
+	 */
+	bool do_cancel(Handle cancel_name);
+
+	/**
+	 * The scheme (cog-ure-open-session) function calls this, to load
+	 * the configuration of the given rule-based system once and for
+	 * all. Until the session is closed, forward and backward chaining
+	 * over that rule-based system reuse it instead of reloading it.
+	 *
+	 * @return             True if a session was already open and has
+	 *                     been reloaded, false otherwise.
+	 */
+	bool do_open_session(Handle rbs);
+
+	/**
+	 * The scheme (cog-ure-close-session) function calls this.
+	 *
+	 * @return             True if such session was open, false
+	 *                     otherwise.
+	 */
+	bool do_close_session(Handle rbs);
+
+	// Return the session of the given rule-based system if open,
+	// nullptr otherwise.
+	URESessionPtr get_session(const Handle& rbs);
+
+	// Open sessions, per rule-based system
+	std::map<Handle, URESessionPtr> _sessions;
+	std::mutex _sessions_mutex;
+
+	/**
+	 * The scheme (cog-ure-profile) function calls this.
+	 *
+	 * @return             The profile of the last chaining over the
+	 *                     given rule-based system, for which profiling
+	 *                     was enabled, or the empty string if none.
+	 */
+	std::string do_ure_profile(Handle rbs);
+
+	// Record the profile of a chaining over the given rule-based
+	// system, if profiling was enabled.
+	void record_profile(const Handle& rbs, const Profiler& profiler);
+
+	// Profile of the last chaining, per rule-based system
+	std::map<Handle, Profiler> _profiles;
+	std::mutex _profiles_mutex;
+
+	/**
+	 * The scheme (cog-ure-load-trace) function calls this, to convert
+	 * a binary trace file back to atomese, into the current
+	 * atomspace.
+	 *
+	 * @return             True if the trace is complete, false if it
+	 *                     has been interrupted.
+	 */
+	bool do_load_trace(const std::string& filename);
 
 	Handle get_rulebase_rules(Handle rbs);
 
@@ -93,17 +197,46 @@ public:
 
 } /*end of namespace opencog*/
 
+#include <opencog/atoms/base/Link.h>
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atoms/truthvalue/TruthValue.h>
 #include <opencog/guile/SchemePrimitive.h>
 
 #include "forwardchainer/ForwardChainer.h"
 #include "backwardchainer/BackwardChainer.h"
 #include "UREConfig.h"
+#include "TraceFile.h"
 
 using namespace opencog;
 
 URESCM::URESCM() : ModuleWrap("opencog ure") {}
 
+// Build a result callback executing the given schema over each new
+// result. An empty ListLink means no callback.
+static ResultCallback mk_result_callback(AtomSpace* as, const Handle& schema)
+{
+	if (schema->get_type() == LIST_LINK)
+		return ResultCallback();
+	return [as, schema](const Handle& result) {
+		Handle args = createLink(HandleSeq{result}, LIST_LINK);
+		createLink(HandleSeq{schema, args}, EXECUTION_OUTPUT_LINK)->execute(as);
+	};
+}
+
+// Build a stop predicate evaluating the given predicate over each new
+// result. An empty ListLink means no predicate.
+static ResultPredicate mk_stop_predicate(AtomSpace* as, const Handle& pred)
+{
+	if (pred->get_type() == LIST_LINK)
+		return ResultPredicate();
+	return [as, pred](const Handle& result) {
+		Handle args = createLink(HandleSeq{result}, LIST_LINK);
+		TruthValuePtr tv =
+			createLink(HandleSeq{pred, args}, EVALUATION_LINK)->evaluate(as);
+		return 0.5 < tv->get_mean();
+	};
+}
+
 /// This is called while (opencog ure) is the current module.
 /// Thus, all the definitions below happen in that module.
 void URESCM::init(void)
@@ -114,6 +247,21 @@ void URESCM::init(void)
 	define_scheme_primitive("cog-mandatory-args-bc",
 		&URESCM::do_backward_chaining, this, "ure");
 
+	define_scheme_primitive("cog-ure-cancel",
+		&URESCM::do_cancel, this, "ure");
+
+	define_scheme_primitive("cog-ure-open-session",
+		&URESCM::do_open_session, this, "ure");
+
+	define_scheme_primitive("cog-ure-close-session",
+		&URESCM::do_close_session, this, "ure");
+
+	define_scheme_primitive("cog-ure-profile",
+		&URESCM::do_ure_profile, this, "ure");
+
+	define_scheme_primitive("cog-ure-load-trace",
+		&URESCM::do_load_trace, this, "ure");
+
 	define_scheme_primitive("cog-ure-logger",
 		&URESCM::do_ure_logger, this, "ure");
 }
@@ -123,7 +271,12 @@ Handle URESCM::do_forward_chaining(Handle rbs,
                                    Handle vardecl,
                                    bool trace_enabled,
                                    AtomSpace *trace_as,
-                                   Handle focus_set_h)
+                                   Handle focus_set_h,
+                                   Handle on_result,
+                                   Handle stop_when,
+                                   Handle cancel_name,
+                                   const std::string& trace_file,
+                                   bool fetch_parameters)
 {
 	AtomSpace *as = SchemeSmob::ss_get_env_as("cog-mandatory-args-fc");
 	HandleSeq focus_set = {};
@@ -142,8 +295,26 @@ Handle URESCM::do_forward_chaining(Handle rbs,
 			TRACE_INFO,
 			"URESCM::do_forward_chaining - focus set should be SET_LINK type!");
 
-	ForwardChainer fc(*as, rbs, source, vardecl, trace_as, focus_set);
+	URESessionPtr session = get_session(rbs);
+	ForwardChainerPtr fcp = session ?
+		session->forward_chainer(*as, source, vardecl, trace_as, focus_set,
+		                         fetch_parameters) :
+		std::make_shared<ForwardChainer>(*as, rbs, source, vardecl,
+		                                 trace_as, focus_set);
+	ForwardChainer& fc = *fcp;
+	fc.set_result_callback(mk_result_callback(as, on_result));
+	fc.set_stop_predicate(mk_stop_predicate(as, stop_when));
+	// A ListLink means that chaining is not named for cancellation
+	CancellationRegistration cancellation(
+		cancel_name->get_type() == LIST_LINK ? Handle::UNDEFINED : cancel_name);
+	fc.set_cancellation_token(cancellation.get_token());
+	TraceWriterPtr trace_writer = trace_file.empty() ?
+		nullptr : createTraceWriter(trace_file);
+	fc.set_trace_writer(trace_writer);
 	fc.do_chain();
+	if (trace_writer)
+		trace_writer->close();
+	record_profile(rbs, fc.get_profiler());
 	return fc.get_results();
 }
 
@@ -154,7 +325,12 @@ Handle URESCM::do_backward_chaining(Handle rbs,
                                     AtomSpace *trace_as,
                                     bool control_enabled,
                                     AtomSpace *control_as,
-                                    Handle focus_link)
+                                    Handle focus_link,
+                                    Handle on_result,
+                                    Handle stop_when,
+                                    Handle cancel_name,
+                                    const std::string& trace_file,
+                                    bool fetch_parameters)
 {
 	// A ListLink means that the variable declaration is undefined
 	if (vardecl->get_type() == LIST_LINK)
@@ -167,13 +343,83 @@ Handle URESCM::do_backward_chaining(Handle rbs,
 		control_as = nullptr;
 
 	AtomSpace *as = SchemeSmob::ss_get_env_as("cog-mandatory-args-bc");
-	BackwardChainer bc(*as, rbs, target, vardecl, trace_as, control_as, focus_link);
+	URESessionPtr session = get_session(rbs);
+	BackwardChainerPtr bcp = session ?
+		session->backward_chainer(*as, target, vardecl, trace_as,
+		                          control_as, focus_link, BITNodeFitness(),
+		                          AndBITFitness(), fetch_parameters) :
+		std::make_shared<BackwardChainer>(*as, rbs, target, vardecl,
+		                                  trace_as, control_as, focus_link);
+	BackwardChainer& bc = *bcp;
+	bc.set_result_callback(mk_result_callback(as, on_result));
+	bc.set_stop_predicate(mk_stop_predicate(as, stop_when));
+	// A ListLink means that chaining is not named for cancellation
+	CancellationRegistration cancellation(
+		cancel_name->get_type() == LIST_LINK ? Handle::UNDEFINED : cancel_name);
+	bc.set_cancellation_token(cancellation.get_token());
+	TraceWriterPtr trace_writer = trace_file.empty() ?
+		nullptr : createTraceWriter(trace_file);
+	bc.set_trace_writer(trace_writer);
 
 	bc.do_chain();
 
+	if (trace_writer)
+		trace_writer->close();
+	record_profile(rbs, bc.get_profiler());
 	return bc.get_results();
 }
 
+bool URESCM::do_cancel(Handle cancel_name)
+{
+	return cancel_registered_token(cancel_name);
+}
+
+bool URESCM::do_open_session(Handle rbs)
+{
+	AtomSpace *as = SchemeSmob::ss_get_env_as("cog-ure-open-session");
+	AtomSpace& rb_as = rbs->getAtomSpace() ? *rbs->getAtomSpace() : *as;
+	URESessionPtr session = createURESession(rb_as, rbs);
+
+	std::lock_guard<std::mutex> lock(_sessions_mutex);
+	bool reloaded = _sessions.find(rbs) != _sessions.end();
+	_sessions[rbs] = session;
+	return reloaded;
+}
+
+bool URESCM::do_close_session(Handle rbs)
+{
+	std::lock_guard<std::mutex> lock(_sessions_mutex);
+	return _sessions.erase(rbs) != 0;
+}
+
+URESessionPtr URESCM::get_session(const Handle& rbs)
+{
+	std::lock_guard<std::mutex> lock(_sessions_mutex);
+	auto it = _sessions.find(rbs);
+	return it != _sessions.end() ? it->second : nullptr;
+}
+
+std::string URESCM::do_ure_profile(Handle rbs)
+{
+	std::lock_guard<std::mutex> lock(_profiles_mutex);
+	auto it = _profiles.find(rbs);
+	return it != _profiles.end() ? it->second.to_string() : "";
+}
+
+void URESCM::record_profile(const Handle& rbs, const Profiler& profiler)
+{
+	if (not profiler.is_enabled())
+		return;
+	std::lock_guard<std::mutex> lock(_profiles_mutex);
+	_profiles[rbs] = profiler;
+}
+
+bool URESCM::do_load_trace(const std::string& filename)
+{
+	AtomSpace *as = SchemeSmob::ss_get_env_as("cog-ure-load-trace");
+	return load_trace(filename, *as);
+}
+
 Logger* URESCM::do_ure_logger()
 {
 	return &ure_logger();
@@ -0,0 +1,115 @@
+/*
+ * URESession.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "URESession.h"
+#include "URELogger.h"
+
+using namespace opencog;
+
+URESession::URESession(AtomSpace& rb_as, const Handle& rbs)
+	: _rbs(rbs), _config(rb_as, rbs), _queries(0)
+{
+}
+
+UREConfig& URESession::get_config()
+{
+	return _config;
+}
+
+const UREConfig& URESession::get_config() const
+{
+	return _config;
+}
+
+const Handle& URESession::get_rbs() const
+{
+	return _rbs;
+}
+
+ForwardChainerPtr URESession::forward_chainer(AtomSpace& kb_as,
+                                              const Handle& source,
+                                              const Handle& vardecl,
+                                              AtomSpace* trace_as,
+                                              const HandleSeq& focus_set,
+                                              bool fetch_parameters)
+{
+	_queries++;
+	std::unique_ptr<UREConfig> fetched;
+	const UREConfig& config = get_config(fetch_parameters, fetched);
+	return std::make_shared<ForwardChainer>(kb_as, config, source, vardecl,
+	                                        trace_as, focus_set);
+}
+
+BackwardChainerPtr URESession::backward_chainer(AtomSpace& kb_as,
+                                                const Handle& target,
+                                                const Handle& vardecl,
+                                                AtomSpace* trace_as,
+                                                AtomSpace* control_as,
+                                                const Handle& focus_set,
+                                                const BITNodeFitness& bitnode_fitness,
+                                                const AndBITFitness& andbit_fitness,
+                                                bool fetch_parameters)
+{
+	_queries++;
+	std::unique_ptr<UREConfig> fetched;
+	const UREConfig& config = get_config(fetch_parameters, fetched);
+
+	// Without control atomspace there is nothing to cache
+	if (not control_as)
+		return std::make_shared<BackwardChainer>(kb_as, config, target,
+		                                         vardecl, trace_as, nullptr,
+		                                         focus_set, bitnode_fitness,
+		                                         andbit_fitness);
+
+	std::lock_guard<std::mutex> lock(_exp_ctrl_rules_mutex);
+	auto it = _exp_ctrl_rules.find(control_as);
+	if (it != _exp_ctrl_rules.end())
+		return std::make_shared<BackwardChainer>(kb_as, config, target,
+		                                         vardecl, trace_as, control_as,
+		                                         focus_set, bitnode_fitness,
+		                                         andbit_fitness, &it->second);
+
+	// First backward chainer with that control atomspace, fetch the
+	// expansion control rules and keep them for the next ones.
+	BackwardChainerPtr bc =
+		std::make_shared<BackwardChainer>(kb_as, config, target, vardecl,
+		                                  trace_as, control_as, focus_set,
+		                                  bitnode_fitness, andbit_fitness);
+	_exp_ctrl_rules[control_as] = bc->get_expansion_control_rules();
+	LAZY_URE_LOG_DEBUG << "Cached the expansion control rules of "
+	                   << _rbs->to_short_string();
+	return bc;
+}
+
+size_t URESession::get_queries() const
+{
+	return _queries;
+}
+
+const UREConfig& URESession::get_config(bool fetch_parameters,
+                                        std::unique_ptr<UREConfig>& fetched) const
+{
+	if (not fetch_parameters)
+		return _config;
+	fetched.reset(new UREConfig(_config));
+	fetched->fetch_parameters(_rbs);
+	return *fetched;
+}
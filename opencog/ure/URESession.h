@@ -0,0 +1,128 @@
+/*
+ * URESession.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_URE_SESSION_H_
+#define _OPENCOG_URE_SESSION_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "UREConfig.h"
+#include "forwardchainer/ForwardChainer.h"
+#include "backwardchainer/BackwardChainer.h"
+
+namespace opencog
+{
+
+/**
+ * Inference session over a given rule-based system. The
+ * configuration, including the rules, is loaded once at construction,
+ * and the expansion control rules of the backward chainer are fetched
+ * once per control atomspace, then chainers are built from them at
+ * near zero cost. Meant for running many queries against the same
+ * rule-based system.
+ *
+ * Changes in the rule-based system, such as parameters set after
+ * the construction of the session, are not taken into account, unless
+ * reflected with get_config(), or, for the parameters, fetched again
+ * for a given chainer, see forward_chainer and backward_chainer.
+ *
+ * Chainers can be created concurrently from multiple threads, as long
+ * as the configuration is not modified meanwhile.
+ */
+class URESession
+{
+public:
+	/**
+	 * @param rb_as     Rule-base atomspace
+	 * @param rbs       Handle pointing to rule-based system.
+	 */
+	URESession(AtomSpace& rb_as, const Handle& rbs);
+
+	/**
+	 * URE configuration accessors. Modifying the configuration affects
+	 * the chainers subsequently created.
+	 */
+	UREConfig& get_config();
+	const UREConfig& get_config() const;
+
+	const Handle& get_rbs() const;
+
+	/**
+	 * Create a forward chainer with the session configuration, see
+	 * ForwardChainer for the description of the arguments. If
+	 * fetch_parameters is true, the parameters of the rule-based
+	 * system are fetched again for that chainer, not the rules.
+	 */
+	ForwardChainerPtr forward_chainer(AtomSpace& kb_as,
+	                                  const Handle& source,
+	                                  const Handle& vardecl=Handle::UNDEFINED,
+	                                  AtomSpace* trace_as=nullptr,
+	                                  const HandleSeq& focus_set=HandleSeq(),
+	                                  bool fetch_parameters=false);
+
+	/**
+	 * Create a backward chainer with the session configuration, see
+	 * BackwardChainer for the description of the arguments, and
+	 * forward_chainer for fetch_parameters.
+	 */
+	BackwardChainerPtr backward_chainer(AtomSpace& kb_as,
+	                                    const Handle& target,
+	                                    const Handle& vardecl=Handle::UNDEFINED,
+	                                    AtomSpace* trace_as=nullptr,
+	                                    AtomSpace* control_as=nullptr,
+	                                    const Handle& focus_set=Handle::UNDEFINED,
+	                                    const BITNodeFitness& bitnode_fitness=BITNodeFitness(),
+	                                    const AndBITFitness& andbit_fitness=AndBITFitness(),
+	                                    bool fetch_parameters=false);
+
+	/**
+	 * Return the number of chainers created so far.
+	 */
+	size_t get_queries() const;
+
+private:
+	/**
+	 * Return the session configuration, or, if fetch_parameters is
+	 * true, a copy of it held by fetched, with the parameters fetched
+	 * again.
+	 */
+	const UREConfig& get_config(bool fetch_parameters,
+	                            std::unique_ptr<UREConfig>& fetched) const;
+
+	Handle _rbs;
+
+	UREConfig _config;
+
+	// Expansion control rules per control atomspace
+	std::map<const AtomSpace*, ExpansionControlRules> _exp_ctrl_rules;
+	std::mutex _exp_ctrl_rules_mutex;
+
+	std::atomic<size_t> _queries;
+};
+
+typedef std::shared_ptr<URESession> URESessionPtr;
+#define createURESession std::make_shared<URESession>
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_URE_SESSION_H_ */
@@ -22,6 +22,8 @@
 #ifndef _OPENCOG_URE_UTILS_H
 #define _OPENCOG_URE_UTILS_H
 
+#include <functional>
+
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/base/Handle.h>
 
@@ -49,6 +51,18 @@ namespace opencog
  */
 bool remove_hypergraph(AtomSpace&, const Handle&);
 
+/**
+ * Callback called by the chainers on each new result, as soon as it
+ * is produced.
+ */
+typedef std::function<void(const Handle&)> ResultCallback;
+
+/**
+ * Predicate over a new result. The chainers stop as soon as a new
+ * result satisfies it.
+ */
+typedef std::function<bool(const Handle&)> ResultPredicate;
+
 } // ~namespace opencog
 
 #endif // _OPENCOG_URE_UTILS_H
@@ -20,11 +20,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <functional>
+
 #include <boost/range/algorithm/binary_search.hpp>
 #include <boost/range/algorithm/lower_bound.hpp>
 #include <boost/range/algorithm/reverse.hpp>
 #include <boost/range/algorithm/unique.hpp>
 #include <boost/range/algorithm/find.hpp>
+#include <boost/range/algorithm/find_if.hpp>
 #include <boost/range/algorithm/sort.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 #include <boost/range/adaptor/reversed.hpp>
@@ -88,11 +91,13 @@ std::string	BITNode::to_string(const std::string& indent) const
 // AndBIT //
 ////////////
 
-AndBIT::AndBIT() : complexity(0), exhausted(false), queried_as(nullptr) {}
+AndBIT::AndBIT() : complexity(0), exhausted(false), queried_as(nullptr),
+                   _leaf2bitnode_set(false), _leaves_inherited(false) {}
 
 AndBIT::AndBIT(AtomSpace& bit_as, const Handle& target, Handle vardecl,
                const BITNodeFitness& fitness, const AtomSpace* qas)
-	: exhausted(false), queried_as(qas)
+	: exhausted(false), queried_as(qas),
+	  _leaf2bitnode_set(true), _leaves_inherited(false)
 {
 	// in case it is undefined
 	if (nullptr == vardecl)
@@ -116,9 +121,11 @@ AndBIT::AndBIT(AtomSpace& bit_as, const Handle& target, Handle vardecl,
 }
 
 AndBIT::AndBIT(const Handle& f, double cpx, const AtomSpace* qas)
-	: fcs(f), complexity(cpx), exhausted(false), queried_as(qas)
+	: fcs(f), complexity(cpx), exhausted(false), queried_as(qas),
+	  _leaf2bitnode_set(false), _leaves_inherited(false)
 {
-	set_leaf2bitnode();         // TODO: might differ till needed to optimize
+	// Most expanded and-BITs never get selected for expansion, so
+	// leaf2bitnode is only built when first needed.
 }
 
 AndBIT::~AndBIT() {}
@@ -127,26 +134,42 @@ AndBIT AndBIT::expand(const Handle& leaf,
                       const RuleTypedSubstitutionPair& rule,
                       double prob) const
 {
-	Handle new_fcs = expand_fcs(leaf, rule);
+	bool shared_rewrite = false;
+	Handle new_fcs = expand_fcs(leaf, rule, &shared_rewrite);
 	double new_cpx = expand_complexity(leaf, prob);
 
 	// Only consider expansions that actually expands
 	if (content_eq(fcs, new_fcs)) {
-		ure_logger().warn() << "The new FCS is equal to the old one. "
-		                    << "There is probably a bug. This expansion has "
-		                    << "been cancelled.";
+		LAZY_URE_LOG_WARN << "The new FCS is equal to the old one. "
+		                  << "There is probably a bug. This expansion has "
+		                  << "been cancelled.";
 		return AndBIT();
 	}
 
 	// Discard expansion with cycle
 	if (has_cycle(BindLinkCast(new_fcs)->get_implicand()[0])) {
-		ure_logger().debug() << "The new FCS has some cycle (some conclusion "
-		                     << "has itself has premise, directly or "
-		                     << "indirectly). This expansion has been cancelled.";
+		LAZY_URE_LOG_DEBUG << "The new FCS has some cycle (some conclusion "
+		                   << "has itself has premise, directly or "
+		                   << "indirectly). This expansion has been cancelled.";
 		return AndBIT();
 	}
 
-	return AndBIT(new_fcs, new_cpx, queried_as);
+	AndBIT new_andbit(new_fcs, new_cpx, queried_as);
+	if (shared_rewrite)
+		new_andbit.inherit_leaves(*this, rule.first);
+	return new_andbit;
+}
+
+AndBIT::HandleBITNodeMap& AndBIT::get_leaf2bitnode()
+{
+	set_leaf2bitnode();
+	return leaf2bitnode;
+}
+
+const AndBIT::HandleBITNodeMap& AndBIT::get_leaf2bitnode() const
+{
+	set_leaf2bitnode();
+	return leaf2bitnode;
 }
 
 BITNode* AndBIT::select_leaf()
@@ -156,7 +179,7 @@ BITNode* AndBIT::select_leaf()
 	// of being selected as it is already fit.
 	std::vector<double> weights;
 	bool all_weights_null = true;
-	for (const auto& lb : leaf2bitnode) {
+	for (const auto& lb : get_leaf2bitnode()) {
 		double p = lb.second();
 		weights.push_back(p);
 		if (p > 0) all_weights_null = false;
@@ -183,45 +206,47 @@ bool AndBIT::has_cycle() const
 	return has_cycle(BindLinkCast(fcs)->get_implicand()[0]);
 }
 
-bool AndBIT::has_cycle(const Handle& h, HandleSet ancestors) const
+bool AndBIT::has_cycle(const Handle& h) const
 {
-	if (h->get_type() == EXECUTION_OUTPUT_LINK) {
-		Handle arg = h->getOutgoingAtom(1);
-		if (arg->get_type() == LIST_LINK) {
-			Handle conclusion = arg->getOutgoingAtom(0);
-			if (contains(ancestors, conclusion))
-				return true;
+	HandleSet ancestors;
+	return has_cycle(h, ancestors);
+}
 
-			ancestors.insert(conclusion);
-			Arity arity = arg->get_arity();
-			if (1 < arity) {
-				bool unordered_premises =
-					arg->getOutgoingAtom(1)->get_type() == SET_LINK;
-				if (unordered_premises) {
-					OC_ASSERT(arity == 2,
-					          "Mixture of ordered and unordered"
-					          " premises not implemented!");
-					arg = arg->getOutgoingAtom(1);
-					for (const Handle& ph : arg->getOutgoingSet())
-						if (has_cycle(ph, ancestors))
-							return true;
-					return false;
-				} else {
-					for (Arity i = 1; i < arity; ++i) {
-						Handle ph = arg->getOutgoingAtom(i);
-						if (has_cycle(ph, ancestors))
-							return true;
-						return false;
-					}
-				}
-			}
-			return false;
-		} else {
-			return contains(ancestors, arg);
-		}
-	} else {
+bool AndBIT::has_cycle(const Handle& h, HandleSet& ancestors) const
+{
+	if (h->get_type() != EXECUTION_OUTPUT_LINK)
 		return contains(ancestors, h);
+
+	Handle arg = h->getOutgoingAtom(1);
+	if (arg->get_type() != LIST_LINK)
+		return contains(ancestors, arg);
+
+	Handle conclusion = arg->getOutgoingAtom(0);
+	if (contains(ancestors, conclusion))
+		return true;
+
+	// Locate the premises, ordered (following the conclusion) or
+	// unordered (wrapped in a SetLink)
+	Arity arity = arg->get_arity();
+	if (arity < 2)
+		return false;
+	const HandleSeq* premises = &arg->getOutgoingSet();
+	size_t first = 1;
+	if (arg->getOutgoingAtom(1)->get_type() == SET_LINK) {
+		OC_ASSERT(arity == 2,
+		          "Mixture of ordered and unordered"
+		          " premises not implemented!");
+		premises = &arg->getOutgoingAtom(1)->getOutgoingSet();
+		first = 0;
 	}
+
+	// Visit the premises with the conclusion as ancestor
+	ancestors.insert(conclusion);
+	bool cycle = false;
+	for (size_t i = first; not cycle and i < premises->size(); i++)
+		cycle = has_cycle((*premises)[i], ancestors);
+	ancestors.erase(conclusion);
+	return cycle;
 }
 
 bool AndBIT::operator==(const AndBIT& andbit) const
@@ -314,22 +339,27 @@ double AndBIT::expand_complexity(const Handle& leaf, double prob) const
 	// complexity of the parent and-BIT with the complexity of the
 	// expanded BIT-node and the complexity of the rule (1 - log(prob))
 	return complexity
-		+ leaf2bitnode.find(leaf)->second.complexity
+		+ get_leaf2bitnode().find(leaf)->second.complexity
 		+ 1 - log(prob);
 }
 
 Handle AndBIT::expand_fcs(const Handle& leaf,
-                          const RuleTypedSubstitutionPair& rule) const
+                          const RuleTypedSubstitutionPair& rule,
+                          bool* shared_rewrite) const
 {
 	// Unify the rule conclusion with the leaf, and substitute any
 	// variables in it by the associated term.
-	Handle nfcs = substitute_unified_variables(leaf, rule.second);
+	HandleSeq nfcs_outgoings = substitute_unified_variables(leaf, rule.second);
 
-	BindLinkPtr nfcs_bl(BindLinkCast(nfcs));
-	Handle nfcs_vardecl = nfcs_bl->get_vardecl();
-	Handle nfcs_pattern = nfcs_bl->get_body();
-	Handle nfcs_rewrite = nfcs_bl->get_implicand()[0]; // assume that there is only one
+	// Assume that there is only one rewrite
+	size_t nfcs_arity = nfcs_outgoings.size();
+	Handle nfcs_vardecl = nfcs_arity == 3 ? nfcs_outgoings[0] : Handle::UNDEFINED;
+	Handle nfcs_pattern = nfcs_outgoings[nfcs_arity - 2];
+	Handle nfcs_rewrite = nfcs_outgoings[nfcs_arity - 1];
 	Handle rule_vardecl = rule.first.get_vardecl();
+	if (shared_rewrite)
+		*shared_rewrite =
+			nfcs_rewrite == BindLinkCast(fcs)->get_implicand()[0];
 
 	// Generate new pattern term
 	Handle npattern = expand_fcs_pattern(nfcs_pattern, rule.first);
@@ -349,7 +379,7 @@ Handle AndBIT::expand_fcs(const Handle& leaf,
 	HandleSeq noutgoings({npattern, nrewrite});
 	if (nvardecl)
 		noutgoings.insert(noutgoings.begin(), nvardecl);
-	nfcs = fcs->getAtomSpace()->add_link(BIND_LINK, std::move(noutgoings));
+	Handle nfcs = fcs->getAtomSpace()->add_link(BIND_LINK, std::move(noutgoings));
 
 	// Log expansion
 	LAZY_URE_LOG_DEBUG << "Expanded forward chainer strategy:" << std::endl
@@ -360,15 +390,44 @@ Handle AndBIT::expand_fcs(const Handle& leaf,
 	return nfcs;
 }
 
-void AndBIT::set_leaf2bitnode()
+void AndBIT::set_leaf2bitnode() const
 {
+	if (_leaf2bitnode_set)
+		return;
+	_leaf2bitnode_set = true;
+
 	// For each leaf of fcs, associate a corresponding BITNode
-	for (const Handle& leaf : get_leaves())
+	for (const Handle& leaf : _leaves_inherited ? _inherited_leaves
+		     : get_leaves())
 		insert_bitnode(leaf, BITNodeFitness());
 }
 
+void AndBIT::inherit_leaves(const AndBIT& parent, const Rule& rule)
+{
+	// The premises of the rule are not in the atomspace yet as atoms
+	// of their own, the ones of the new FCS are retrieved instead. If
+	// any is missing just let the leaves be collected from the FCS.
+	AtomSpace& as = *fcs->getAtomSpace();
+	HandleSet leaves;
+	for (const Handle& premise : get_leaves(rule.get_implicand())) {
+		Handle leaf = as.get_atom(premise);
+		if (not leaf)
+			return;
+		leaves.insert(leaf);
+	}
+
+	// All parent leaves but the expanded ones remain
+	Handle conclusion = rule.get_conclusions()[0].second;
+	for (const auto& lb : parent.get_leaf2bitnode())
+		if (not content_eq(lb.first, conclusion))
+			leaves.insert(lb.first);
+
+	_inherited_leaves = std::move(leaves);
+	_leaves_inherited = true;
+}
+
 AndBIT::HandleBITNodeMap::iterator
-AndBIT::insert_bitnode(Handle leaf, const BITNodeFitness& fitness)
+AndBIT::insert_bitnode(Handle leaf, const BITNodeFitness& fitness) const
 {
 	if (not leaf)
 		return leaf2bitnode.end();
@@ -424,11 +483,12 @@ HandleSet AndBIT::get_leaves(const Handle& h) const
 	return HandleSet{h};
 }
 
-Handle AndBIT::substitute_unified_variables(const Handle& leaf,
-                                            const Unify::TypedSubstitution& ts) const
+HandleSeq AndBIT::substitute_unified_variables(const Handle& leaf,
+                                               const Unify::TypedSubstitution& ts) const
 {
 	BindLinkPtr fcs_bl(BindLinkCast(fcs));
-	return Handle(Unify::substitute(fcs_bl, ts, queried_as));
+	return Unify::substitute_outgoings(fcs_bl, strip_context(ts.first),
+	                                   ts.second, queried_as);
 }
 
 Handle AndBIT::expand_fcs_pattern(const Handle& fcs_pattern,
@@ -479,9 +539,9 @@ Handle AndBIT::expand_fcs_rewrite(const Handle& fcs_rewrite,
 	if (content_eq(fcs_rewrite, conclusion))
 		return rule.get_implicand();
 
-	// Recursive cases
+	// Recursive cases. Subterms left unchanged are returned as is so
+	// that they are shared with the parent FCS.
 
-	AtomSpace& as = *fcs->getAtomSpace();
 	Type t = fcs_rewrite->get_type();
 
 	if (t == EXECUTION_OUTPUT_LINK) {
@@ -489,20 +549,32 @@ Handle AndBIT::expand_fcs_rewrite(const Handle& fcs_rewrite,
 		// argument as it is a conclusion already.
 		Handle gsn = fcs_rewrite->getOutgoingAtom(0);
 		Handle arg = fcs_rewrite->getOutgoingAtom(1);
-		if (arg->get_type() == LIST_LINK) {
-			HandleSeq args = arg->getOutgoingSet();
-			for (size_t i = 1; i < args.size(); i++)
-				args[i] = expand_fcs_rewrite(args[i], rule);
-			arg = as.add_link(LIST_LINK, std::move(args));
+		if (arg->get_type() != LIST_LINK)
+			return fcs_rewrite;
+		HandleSeq args = arg->getOutgoingSet();
+		bool changed = false;
+		for (size_t i = 1; i < args.size(); i++) {
+			Handle narg = expand_fcs_rewrite(args[i], rule);
+			changed |= narg != args[i];
+			args[i] = narg;
 		}
-		return as.add_link(EXECUTION_OUTPUT_LINK, {gsn, arg});
+		if (not changed)
+			return fcs_rewrite;
+		arg = createLink(std::move(args), LIST_LINK);
+		return createLink(HandleSeq{gsn, arg}, EXECUTION_OUTPUT_LINK);
 	} else if (t == SET_LINK) {
 		// If a SetLink then treat its arguments as (unordered)
 		// premises.
 		HandleSeq args = fcs_rewrite->getOutgoingSet();
-		for (size_t i = 0; i < args.size(); i++)
-			args[i] = expand_fcs_rewrite(args[i], rule);
-		return as.add_link(SET_LINK, std::move(args));
+		bool changed = false;
+		for (size_t i = 0; i < args.size(); i++) {
+			Handle narg = expand_fcs_rewrite(args[i], rule);
+			changed |= narg != args[i];
+			args[i] = narg;
+		}
+		if (not changed)
+			return fcs_rewrite;
+		return createLink(std::move(args), SET_LINK);
 	} else
 		// If none of the conditions apply just leave alone. Indeed,
 		// assuming that the pattern matcher is executing the rewrite
@@ -546,13 +618,13 @@ Handle AndBIT::mk_pattern(HandleSeq prs_clauses, HandleSeq virt_clauses) const
 	remove_redundant(prs_clauses);
 	remove_redundant(virt_clauses);
 
-	// Assemble the body
-	AtomSpace& as = *fcs->getAtomSpace();
+	// Assemble the body. It is only inserted in the atomspace along
+	// with the FCS that contains it.
 	if (not prs_clauses.empty())
-		virt_clauses.push_back(as.add_link(PRESENT_LINK, std::move(prs_clauses)));
+		virt_clauses.push_back(createLink(std::move(prs_clauses), PRESENT_LINK));
 	return virt_clauses.empty() ? Handle::UNDEFINED
 		: (virt_clauses.size() == 1 ? virt_clauses.front()
-		   : as.add_link(AND_LINK, std::move(virt_clauses)));
+		   : createLink(std::move(virt_clauses), AND_LINK));
 }
 
 void AndBIT::remove_redundant(HandleSeq& hs)
@@ -792,17 +864,28 @@ std::string AndBIT::line_separator(const std::string& up_aa,
 // BIT //
 /////////
 
-BIT::BIT() : _as(nullptr) {}
+BIT::BIT() : _as(nullptr), _reclaimed_atoms_count(0) {}
 
 BIT::BIT(AtomSpace& as,
          const Handle& target,
          const Handle& vardecl,
          const BITNodeFitness& fitness)
+	: BIT(as, HandleSeq{target}, HandleSeq{vardecl}, fitness)
+{
+}
+
+BIT::BIT(AtomSpace& as,
+         const HandleSeq& targets,
+         const HandleSeq& vardecls,
+         const BITNodeFitness& fitness)
 	: bit_as(&as), // child atomspace of as
-	  _as(&as), _init_target(target), _init_vardecl(vardecl),
-	  _init_fitness(fitness)
+	  _as(&as), _init_targets(targets), _init_vardecls(vardecls),
+	  _init_fitness(fitness), _reclaimed_atoms_count(0)
 {
 	bit_as.clear_copy_on_write();
+	if (_init_vardecls.empty())
+		_init_vardecls.resize(_init_targets.size());
+	OC_ASSERT(_init_vardecls.size() == _init_targets.size());
 }
 
 BIT::~BIT() {}
@@ -817,15 +900,89 @@ size_t BIT::size() const
 	return andbits.size();
 }
 
+size_t BIT::reclaim()
+{
+	// Mark the atoms reachable from the initial targets and the live
+	// and-BITs. The leaves are sub-atoms of the FCSes but are marked
+	// anyway as they are referred to by the BIT-nodes.
+	HandleSet live;
+	std::function<void(const Handle&)> mark = [&](const Handle& h) {
+		if (not h or not live.insert(h).second)
+			return;
+		if (h->is_link())
+			for (const Handle& oh : h->getOutgoingSet())
+				mark(oh);
+	};
+	for (const Handle& target : _init_targets)
+		mark(target);
+	for (const Handle& vardecl : _init_vardecls)
+		mark(vardecl);
+	// The leaves of an and-BIT are subterms of its FCS, thus marked
+	// along with it. The rules expanding its BIT-nodes, and their
+	// substitutions, may refer to atoms of bit_as no longer in any
+	// FCS, so they are marked as well.
+	for (const AndBIT& andbit : andbits) {
+		mark(andbit.fcs);
+		for (const auto& lb : andbit.leaf2bitnode) {
+			for (const RuleTypedSubstitutionPair& rule : lb.second.rules) {
+				mark(rule.first.get_rule());
+				for (const auto& vv : rule.second.first) {
+					mark(vv.first);
+					mark(vv.second.handle);
+				}
+				mark(rule.second.second);
+			}
+		}
+	}
+
+	// Sweep the atoms of bit_as, not of its parent, that are not
+	// marked. As no marked atom can have an unmarked outgoing, removing
+	// the incoming set of an unmarked atom only removes unmarked atoms.
+	size_t prev_count = get_atoms_count();
+	HandleSeq atoms;
+	bit_as.get_handles_by_type(atoms, ATOM, true, false);
+	for (const Handle& h : atoms)
+		if (live.find(h) == live.end())
+			bit_as.extract_atom(h, true);
+
+	size_t removed = prev_count - get_atoms_count();
+	_reclaimed_atoms_count += removed;
+	return removed;
+}
+
+size_t BIT::get_atoms_count() const
+{
+	return bit_as.get_size();
+}
+
+size_t BIT::get_reclaimed_atoms_count() const
+{
+	return _reclaimed_atoms_count;
+}
+
+void BIT::set_queried_as(AtomSpace* as)
+{
+	_as = as;
+}
+
 AndBIT* BIT::init()
 {
-	andbits.emplace_back(bit_as, _init_target,
-	                     _init_vardecl, _init_fitness, _as);
+	Handle first_fcs;
+	for (size_t i = 0; i < _init_targets.size(); i++) {
+		AndBIT andbit(bit_as, _init_targets[i], _init_vardecls[i],
+		              _init_fitness, _as);
+		if (i == 0)
+			first_fcs = andbit.fcs;
+
+		LAZY_URE_LOG_DEBUG << "Initialize BIT with:" << std::endl
+		                   << andbit.to_string();
 
-	LAZY_URE_LOG_DEBUG << "Initialize BIT with:" << std::endl
-	                   << andbits.begin()->to_string();
+		insert(andbit);
+	}
 
-	return &*andbits.begin();
+	auto it = boost::find_if(andbits, [&](const AndBIT& andbit) {
+			return andbit.fcs == first_fcs; });
+	return it != andbits.end() ? &*it : nullptr;
 }
 
 AndBIT* BIT::expand(AndBIT& andbit, BITNode& bitleaf,
@@ -833,8 +990,8 @@ AndBIT* BIT::expand(AndBIT& andbit, BITNode& bitleaf,
 {
 	// Make sure that the rule is not already an or-child of bitleaf.
 	if (contains(bitleaf, rule)) {
-		ure_logger().debug() << "An equivalent rule has already expanded "
-		                     << "that BIT-node, abort expansion";
+		LAZY_URE_LOG_DEBUG << "An equivalent rule has already expanded "
+		                   << "that BIT-node, abort expansion";
 		return nullptr;
 	}
 
@@ -880,6 +1037,21 @@ bool BIT::contains(const BITNode& bitnode,
 	return bitnode.rules.find(rule.first) != bitnode.rules.end();
 }
 
+const HandleSeq& BIT::get_init_targets() const
+{
+	return _init_targets;
+}
+
+const HandleSeq& BIT::get_init_vardecls() const
+{
+	return _init_vardecls;
+}
+
+const BITNodeFitness& BIT::get_init_fitness() const
+{
+	return _init_fitness;
+}
+
 std::string oc_to_string(const BITNode& bitnode, const std::string& indent)
 {
 	return bitnode.to_string(indent);
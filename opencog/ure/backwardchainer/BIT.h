@@ -86,9 +86,10 @@ public:
 	// FCS associated to the and-BIT
 	Handle fcs;
 
-	// Mapping from the FCS leaves to BITNodes
+	// Mapping from the FCS leaves to BITNodes. It is only built when
+	// first needed, see get_leaf2bitnode.
 	typedef std::unordered_map<Handle, BITNode> HandleBITNodeMap;
-	HandleBITNodeMap leaf2bitnode;
+	mutable HandleBITNodeMap leaf2bitnode;
 
 	// The complexity of an and-BIT is the sum of the complexities of
 	// the steps involved in producing it. More specifically the steps
@@ -135,6 +136,13 @@ public:
 	              const RuleTypedSubstitutionPair& rule,
 	              double prob=1.0) const;
 
+	/**
+	 * @brief Return the mapping from the FCS leaves to BITNodes,
+	 * building it first if it has not been built yet.
+	 */
+	HandleBITNodeMap& get_leaf2bitnode();
+	const HandleBITNodeMap& get_leaf2bitnode() const;
+
 	/**
 	 * @brief Randomly select a leaf of the FCS. Leaves with lower
 	 * BIT-node fitness have more chance of being selected (cause they
@@ -169,7 +177,7 @@ public:
 	 * present in the same branch path, so is [14389148767193402296][1].
 	 */
 	bool has_cycle() const;
-	bool has_cycle(const Handle& h, HandleSet ancestors = {}) const;
+	bool has_cycle(const Handle& h) const;
 
 	/**
 	 * Comparison operators. For operator< compare fcs by complexity, or by
@@ -273,16 +281,38 @@ private:
 	 * https://github.com/opencog/atomspace/issues/903. TODO:
 	 * copy/paste the doc here and in the wiki as well.
 	 *
+	 * The new FCS shares with the parent FCS all subterms left
+	 * unchanged by the expansion. Intermediary terms are built
+	 * outside of any atomspace, only the resulting FCS is inserted
+	 * in the atomspace of the parent FCS.
+	 *
+	 * If shared_rewrite is provided, it is set to true iff the
+	 * rewrite term of this FCS has been left untouched by the unified
+	 * variable substitution, in which case the leaves of the new FCS
+	 * can be derived from the ones of this FCS.
+	 *
 	 * TODO: give examples.
 	 */
 	Handle expand_fcs(const Handle& leaf,
-	                  const RuleTypedSubstitutionPair& rule) const;
+	                  const RuleTypedSubstitutionPair& rule,
+	                  bool* shared_rewrite=nullptr) const;
 
 	/**
 	 * @brief Given that FCS is defined generate the mapping from FCS
-	 * leaves to bitnotes.
+	 * leaves to bitnotes. The leaves are the ones inherited from the
+	 * parent and-BIT, if any, otherwise they are collected from the
+	 * FCS.
+	 */
+	void set_leaf2bitnode() const;
+
+	/**
+	 * @brief Given the parent and-BIT, of which the rewrite term has
+	 * been left untouched by the unified variable substitution, and
+	 * the rule it has been expanded with, set the leaves of this
+	 * and-BIT to the leaves of the parent, minus the rule conclusion,
+	 * plus the rule premises.
 	 */
-	void set_leaf2bitnode();
+	void inherit_leaves(const AndBIT& parent, const Rule& rule);
 
 	/**
 	 * @brief Build the BITNode associated to leaf, insert it in
@@ -290,7 +320,7 @@ private:
 	 * the iterator or the existing BITNode.
 	 */
 	HandleBITNodeMap::iterator
-	insert_bitnode(Handle leaf, const BITNodeFitness& fitness);
+	insert_bitnode(Handle leaf, const BITNodeFitness& fitness) const;
 
 	/**
 	 * Return all the leaves (or blanket because these new target
@@ -304,8 +334,11 @@ private:
 	 * Given a FCS, a leaf of it and a rule and its associated typed
 	 * substitution. Substitution the FCS according to the typed
 	 * substitution.
+	 *
+	 * Return the outgoings of the substituted FCS, [vardecl,]
+	 * pattern, rewrite, without creating the BindLink itself.
 	 */
-	Handle substitute_unified_variables(const Handle& leaf,
+	HandleSeq substitute_unified_variables(const Handle& leaf,
 	                                    const Unify::TypedSubstitution& ts) const;
 
 	/**
@@ -417,6 +450,14 @@ private:
 	static std::string remove_consonants(std::string str, size_t tg_size);
 	static std::string abbreviate(std::string str, size_t tg_size);
 
+	/**
+	 * Depth-first cycle detection. ancestors holds the conclusions
+	 * along the path from the root to h. It is restored before
+	 * returning so that a single set is used for the whole traversal,
+	 * making it linear in the size of the rewrite term.
+	 */
+	bool has_cycle(const Handle& h, HandleSet& ancestors) const;
+
 	/**
 	 * Given an ascii art, produce a string that seperates the upper
 	 * and lower ascii arts.
@@ -425,6 +466,15 @@ private:
 	                                  const std::string& low_aa,
 	                                  const Handle& gsn,
 	                                  bool unordered_premises=false);
+
+	// True iff leaf2bitnode has been built
+	mutable bool _leaf2bitnode_set;
+
+	// Leaves inherited from the parent and-BIT, used to build
+	// leaf2bitnode without walking the FCS, if _leaves_inherited is
+	// true.
+	HandleSet _inherited_leaves;
+	bool _leaves_inherited;
 };
 
 /**
@@ -451,6 +501,16 @@ public:
 	BIT(); // Dummy BIT, for testing
 	BIT(AtomSpace& as, const Handle& target, const Handle& vardecl,
 	    const BITNodeFitness& fitness=BITNodeFitness());
+
+	/**
+	 * BIT over a batch of targets, each with its own initial and-BIT.
+	 * And-BITs, initial or expanded, are only merged if identical, see
+	 * insert, thus BIT-nodes are not shared across targets. vardecls
+	 * is either empty, or has the same size as targets, with possibly
+	 * undefined variable declarations.
+	 */
+	BIT(AtomSpace& as, const HandleSeq& targets, const HandleSeq& vardecls,
+	    const BITNodeFitness& fitness=BITNodeFitness());
 	~BIT();
 
 	/**
@@ -464,7 +524,17 @@ public:
 	size_t size() const;
 
 	/**
-	 * @brief Initialize the BIT and return the initial and-BIT.
+	 * @brief Set the queried atomspace, where the constant clauses
+	 * of the and-BITs are looked up to be removed. Null to keep them
+	 * all, so that they are checked at fulfillment, such as when
+	 * queries are restricted to a focus set. Must be called before
+	 * init.
+	 */
+	void set_queried_as(AtomSpace* as);
+
+	/**
+	 * @brief Initialize the BIT with one and-BIT per target and
+	 * return the initial and-BIT of the first target.
 	 */
 	AndBIT* init();
 
@@ -494,6 +564,23 @@ public:
 	 */
 	template<typename It> AndBITs::iterator erase(It pos);
 
+	/**
+	 * Remove from bit_as all atoms that are no longer reachable from
+	 * the live and-BITs, that is not part of their FCSes, or the
+	 * initial targets. Unlike erase, which only removes the atoms of
+	 * an FCS that have no incoming links, this removes dead atoms
+	 * referring to each other as well. Return the number of removed
+	 * atoms.
+	 */
+	size_t reclaim();
+
+	/**
+	 * Memory metrics: number of atoms currently in bit_as, and total
+	 * number of atoms removed by reclaim.
+	 */
+	size_t get_atoms_count() const;
+	size_t get_reclaimed_atoms_count() const;
+
 	/**
 	 * Reset to false all and-BITs exhausted flags.
 	 */
@@ -511,13 +598,22 @@ public:
 	bool contains(const BITNode& bitnode,
 	              const RuleTypedSubstitutionPair& rule) const;
 
+	/**
+	 * Initial targets, their variable declarations and fitness.
+	 */
+	const HandleSeq& get_init_targets() const;
+	const HandleSeq& get_init_vardecls() const;
+	const BITNodeFitness& get_init_fitness() const;
+
 private:
 	// Queried atomspace
 	AtomSpace* _as;
 
-	Handle _init_target;
-	Handle _init_vardecl;
+	HandleSeq _init_targets;
+	HandleSeq _init_vardecls;
 	BITNodeFitness _init_fitness;
+
+	size_t _reclaimed_atoms_count;
 };
 
 template<typename It>
@@ -23,12 +23,17 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <fstream>
+
 #include <opencog/util/random.h>
 
+#include <opencog/atoms/core/VariableList.h>
 #include <opencog/unify/Unify.h>
 
 #include "BackwardChainer.h"
 #include "../URELogger.h"
+#include "../Checkpoint.h"
 
 using namespace opencog;
 
@@ -39,24 +44,86 @@ BackwardChainer::BackwardChainer(AtomSpace& kb_as,
                                  const Handle& vardecl,
                                  AtomSpace* trace_as,
                                  AtomSpace* control_as,
-                                 const Handle& focus_set, // TODO:
-                                                          // support
-                                                          // focus_set
+                                 const Handle& focus_set,
                                  const BITNodeFitness& bitnode_fitness,
                                  const AndBITFitness& andbit_fitness)
+	: BackwardChainer(kb_as, UREConfig(rb_as, rbs), target, vardecl,
+	                  trace_as, control_as, focus_set, bitnode_fitness,
+	                  andbit_fitness)
+{
+}
+
+BackwardChainer::BackwardChainer(AtomSpace& kb_as,
+                                 const UREConfig& config,
+                                 const Handle& target,
+                                 const Handle& vardecl,
+                                 AtomSpace* trace_as,
+                                 AtomSpace* control_as,
+                                 const Handle& focus_set,
+                                 const BITNodeFitness& bitnode_fitness,
+                                 const AndBITFitness& andbit_fitness,
+                                 const ExpansionControlRules* exp_ctrl_rules)
+	: BackwardChainer(kb_as, config, HandleSeq{target}, HandleSeq{vardecl},
+	                  trace_as, control_as, focus_set, bitnode_fitness,
+	                  andbit_fitness, exp_ctrl_rules)
+{
+}
+
+BackwardChainer::BackwardChainer(AtomSpace& kb_as,
+                                 const UREConfig& config,
+                                 const HandleSeq& targets,
+                                 const HandleSeq& vardecls,
+                                 AtomSpace* trace_as,
+                                 AtomSpace* control_as,
+                                 const Handle& focus_set,
+                                 const BITNodeFitness& bitnode_fitness,
+                                 const AndBITFitness& andbit_fitness,
+                                 const ExpansionControlRules* exp_ctrl_rules)
 	: _kb_as(kb_as),
-	  _rb_as(rb_as),
-	  _config(_rb_as, rbs),
-	  _bit(kb_as, target, vardecl, bitnode_fitness),
+	  _rb_as(config.get_atomspace()),
+	  _config(config),
+	  _focus_set(createFocusSet()),
+	  _search_focus_set((bool)focus_set),
+	  _scratch_as(createAtomSpace(&kb_as)),
+	  _budget(_config, [this]() { return _results.size(); }),
+	  _profiler(_config.get_profile()),
+	  _bit(kb_as, targets, vardecls, bitnode_fitness),
+	  _bit_reclaim_size(1024),
 	  _andbit_fitness(andbit_fitness),
 	  _trace_recorder(trace_as),
-	  _control(_config, _bit, target, control_as),
+	  _control(_config, _bit, targets, control_as, exp_ctrl_rules),
 	  _rules(_control.rules),
 	  _iteration(0),
-	  _last_expansion_andbit(nullptr)
+	  _last_expansion_andbit(nullptr),
+	  _init_fulfillment(false),
+	  _stop_requested(false),
+	  _cancellation_token(createCancellationToken())
 {
-	// Record the target in the trace atomspace
-	_trace_recorder.target(target);
+	if (targets.empty())
+		throw RuntimeException(TRACE_INFO,
+			"BackwardChainer - at least one target is required");
+
+	// Record the targets in the trace atomspace
+	for (const Handle& target : targets)
+		_trace_recorder.target(target);
+
+	if (1 < targets.size())
+		_target_results.resize(targets.size());
+
+	// Copy-on-write, so that running an FCS does not modify the TVs
+	// of _kb_as behind our back (see fulfill_fcs).
+	_scratch_as->set_copy_on_write();
+
+	// Put the focus set atoms under focus. Constant clauses are not
+	// removed by looking them up in the whole knowledge-base, they are
+	// kept to be checked against the focus set at fulfillment.
+	if (_search_focus_set) {
+		HandleSeq focus_atoms = focus_set->get_type() == SET_LINK ?
+			focus_set->getOutgoingSet() : HandleSeq{focus_set};
+		for (const Handle& h : focus_atoms)
+			_focus_set->insert(_kb_as.add_atom(h));
+		_bit.set_queried_as(nullptr);
+	}
 }
 
 BackwardChainer::BackwardChainer(AtomSpace& kb_as,
@@ -75,6 +142,23 @@ BackwardChainer::BackwardChainer(AtomSpace& kb_as,
 {
 }
 
+BackwardChainer::BackwardChainer(std::istream& checkpoint,
+                                 AtomSpace& kb_as,
+                                 AtomSpace& rb_as,
+                                 const Handle& rbs,
+                                 const Handle& target,
+                                 const Handle& vardecl,
+                                 AtomSpace* trace_as,
+                                 AtomSpace* control_as,
+                                 const Handle& focus_set,
+                                 const BITNodeFitness& bitnode_fitness,
+                                 const AndBITFitness& andbit_fitness)
+	: BackwardChainer(kb_as, rb_as, rbs, target, vardecl, trace_as,
+	                  control_as, focus_set, bitnode_fitness, andbit_fitness)
+{
+	load_checkpoint(checkpoint);
+}
+
 UREConfig& BackwardChainer::get_config()
 {
 	return _config;
@@ -97,18 +181,36 @@ void BackwardChainer::do_chain()
 
 	LAZY_URE_LOG_DEBUG << "Finished backward chaining with results:"
 	                   << std::endl << oc_to_string(get_results_set());
+	if (_profiler.is_enabled()) {
+		LAZY_URE_LOG_INFO << "Backward chaining profile:" << std::endl
+		                  << oc_to_string(_profiler);
+	}
+
+	// Write the timeline, if any is to be written
+	const TimelinePtr& timeline = _profiler.get_timeline();
+	if (timeline and not timeline->get_filename().empty())
+		timeline->write();
 }
 
 void BackwardChainer::do_step()
 {
+	_budget.start();
 	_iteration++;
+	Profiler::Timer timer(_profiler, Profiler::BC_ITERATION, _iteration);
+	Budget::Step budget_step(_budget);
 
-	ure_logger().debug() << "Iteration " << _iteration
-	                     << "/" << _config.get_maximum_iterations_str();
+	LAZY_URE_LOG_DEBUG << "Iteration " << _iteration
+	                   << "/" << _config.get_maximum_iterations_str();
 
 	expand_bit();
+
+	// Skip fulfillment, possibly expensive, if cancelled meanwhile
+	if (_cancellation_token->is_cancelled())
+		return;
+
 	fulfill_bit();
 	reduce_bit();
+	reclaim_bit();
 }
 
 bool BackwardChainer::termination()
@@ -116,17 +218,33 @@ bool BackwardChainer::termination()
 	bool terminate = false;
 	std::string msg;            // Cause of the termination
 
-	if (_config.get_maximum_iterations() == _iteration) {
+	if (_cancellation_token->is_cancelled()) {
+		msg = "chaining has been cancelled";
+		terminate = true;
+	}
+	else if (_stop_requested) {
+		msg = "a result has satisfied the stop predicate";
+		terminate = true;
+	}
+	else if (_config.get_maximum_iterations() == _iteration) {
 		msg = "reached the maximum number of iterations";
 		terminate = true;
 	}
+	else if (not (msg = _budget.exhausted()).empty()) {
+		terminate = true;
+	}
+	else if (0 <= _config.get_max_bit_atoms() and
+	         _config.get_max_bit_atoms() <= _bit.bit_as.get_size()) {
+		msg = "reached the maximum number of atoms in the BIT atomspace";
+		terminate = true;
+	}
 	else if (not _bit.empty() and _bit.andbits_exhausted()) {
 		msg = "all AndBITS are exhausted";
 		terminate = true;
 	}
 
 	if (terminate)
-		ure_logger().debug() << "Terminate: " << msg;
+		LAZY_URE_LOG_DEBUG << "Terminate: " << msg;
 
 	return terminate;
 }
@@ -142,6 +260,203 @@ const HandleSet& BackwardChainer::get_results_set() const
 	return _results;
 }
 
+int BackwardChainer::get_iteration() const
+{
+	return _iteration;
+}
+
+Profiler& BackwardChainer::get_profiler()
+{
+	return _profiler;
+}
+
+const Profiler& BackwardChainer::get_profiler() const
+{
+	return _profiler;
+}
+
+void BackwardChainer::set_trace_writer(const TraceWriterPtr& writer)
+{
+	_trace_recorder.set_writer(writer);
+
+	// The targets have been recorded at construction
+	if (writer)
+		for (const Handle& target : _bit.get_init_targets())
+			writer->target(target);
+}
+
+Handle BackwardChainer::get_results(const Handle& target) const
+{
+	const HandleSeq& targets = _bit.get_init_targets();
+	auto it = std::find(targets.begin(), targets.end(), target);
+	if (it == targets.end())
+		throw RuntimeException(TRACE_INFO,
+			"BackwardChainer - %s is not one of the targets",
+			oc_to_string(target).c_str());
+
+	// Single target, all results are its own
+	if (_target_results.empty())
+		return get_results();
+
+	const HandleSet& trs = _target_results[std::distance(targets.begin(), it)];
+	HandleSeq results(trs.begin(), trs.end());
+	return _kb_as.add_link(SET_LINK, std::move(results));
+}
+
+HandleSeq BackwardChainer::get_results_since(size_t pos) const
+{
+	if (_results_seq.size() <= pos)
+		return {};
+	return HandleSeq(std::next(_results_seq.begin(), pos), _results_seq.end());
+}
+
+size_t BackwardChainer::get_bit_atoms_count() const
+{
+	return _bit.get_atoms_count();
+}
+
+size_t BackwardChainer::get_reclaimed_bit_atoms_count() const
+{
+	return _bit.get_reclaimed_atoms_count();
+}
+
+void BackwardChainer::set_result_callback(const ResultCallback& callback)
+{
+	_result_callback = callback;
+}
+
+void BackwardChainer::set_stop_predicate(const ResultPredicate& predicate)
+{
+	_stop_predicate = predicate;
+}
+
+void BackwardChainer::cancel()
+{
+	_cancellation_token->cancel();
+}
+
+void BackwardChainer::set_cancellation_token(const CancellationTokenPtr& token)
+{
+	_cancellation_token = token;
+}
+
+const CancellationTokenPtr& BackwardChainer::get_cancellation_token() const
+{
+	return _cancellation_token;
+}
+
+const ExpansionControlRules& BackwardChainer::get_expansion_control_rules() const
+{
+	return _control.get_expansion_control_rules();
+}
+
+void BackwardChainer::save_checkpoint(std::ostream& out) const
+{
+	CheckpointWriter writer(out);
+	writer.write_header('B');
+
+	// Initial targets, to make sure the checkpoint is resumed by the
+	// right chainer
+	writer.write_handles(_bit.get_init_targets());
+	writer.write_handles(_bit.get_init_vardecls());
+
+	writer.write_size(_iteration);
+
+	// Results in their order of production
+	writer.write_handles(_results_seq);
+
+	// And-BITs, alongside the state of their leaves. Leaves that have
+	// not been built yet are in their initial state, thus not saved.
+	writer.write_size(_bit.andbits.size());
+	for (const AndBIT& andbit : _bit.andbits) {
+		writer.write_handle(andbit.fcs);
+		writer.write_double(andbit.complexity);
+		writer.write_bool(andbit.exhausted);
+		writer.write_size(andbit.leaf2bitnode.size());
+		for (const auto& lb : andbit.leaf2bitnode) {
+			writer.write_handle(lb.first);
+			writer.write_double(lb.second.complexity);
+			writer.write_bool(lb.second.exhausted);
+		}
+	}
+
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"BackwardChainer - failed to write checkpoint");
+}
+
+void BackwardChainer::save_checkpoint(const std::string& filename) const
+{
+	std::ofstream out(filename, std::ios::binary);
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"BackwardChainer - cannot open %s", filename.c_str());
+	save_checkpoint(out);
+}
+
+void BackwardChainer::load_checkpoint(std::istream& in)
+{
+	CheckpointReader reader(in);
+	reader.read_header('B');
+
+	const HandleSeq& targets = _bit.get_init_targets();
+	HandleSeq init_targets = reader.read_handles(_bit.bit_as);
+	HandleSeq init_vardecls = reader.read_handles(_bit.bit_as);
+	const HandleSeq& vardecls = _bit.get_init_vardecls();
+	bool same_targets = init_targets.size() == targets.size() and
+		init_vardecls.size() == vardecls.size();
+	for (size_t i = 0; same_targets and i < targets.size(); i++)
+		same_targets = content_eq(init_targets[i], targets[i]) and
+			content_eq(init_vardecls[i], vardecls[i]);
+	if (not same_targets)
+		throw RuntimeException(TRACE_INFO,
+			"BackwardChainer - the checkpoint does not correspond "
+			"to targets %s", oc_to_string(targets).c_str());
+
+	_iteration = reader.read_size();
+
+	// Results are dumped in the knowledge base, as if they had just
+	// been proven, thus are put under focus as well.
+	for (const Handle& result : reader.read_handles(_kb_as)) {
+		if (_results.insert(result).second) {
+			_results_seq.push_back(result);
+			route_result(result);
+		}
+		if (_search_focus_set)
+			_focus_set->insert(result);
+	}
+
+	// And-BITs. Their leaves are re-created from their FCS and their
+	// states restored. The rules that have already expanded
+	// each leaf are not saved, an expansion that has already been done
+	// will simply be discarded as the resulting and-BIT is already in
+	// the BIT.
+	size_t andbits_size = reader.read_size();
+	for (size_t i = 0; i < andbits_size; i++) {
+		Handle fcs = reader.read_handle(_bit.bit_as);
+		double complexity = reader.read_double();
+		AndBIT andbit(fcs, complexity, &_kb_as);
+		andbit.exhausted = reader.read_bool();
+		size_t leaves_size = reader.read_size();
+		for (size_t j = 0; j < leaves_size; j++) {
+			Handle leaf = reader.read_handle(_bit.bit_as);
+			double leaf_complexity = reader.read_double();
+			bool leaf_exhausted = reader.read_bool();
+			auto it = andbit.get_leaf2bitnode().find(leaf);
+			if (it == andbit.get_leaf2bitnode().end())
+				continue;
+			it->second.complexity = leaf_complexity;
+			it->second.exhausted = leaf_exhausted;
+			for (const Handle& target : targets)
+				if (content_eq(leaf, target))
+					it->second.fitness = _bit.get_init_fitness();
+		}
+		_bit.insert(andbit);
+	}
+
+	_last_expansion_andbit = nullptr;
+}
+
 void BackwardChainer::expand_meta_rules()
 {
 	// This is kinda of hack before meta rules are fully supported by
@@ -153,9 +468,9 @@ void BackwardChainer::expand_meta_rules()
 	// flags.
 	if (rules_size != _rules.size()) {
 		_bit.reset_exhausted_flags();
-		ure_logger().debug() << "The rule set has gone from "
-		                     << rules_size << " rules to " << _rules.size()
-		                     << ". All exhausted flags have been reset.";
+		LAZY_URE_LOG_DEBUG << "The rule set has gone from "
+		                   << rules_size << " rules to " << _rules.size()
+		                   << ". All exhausted flags have been reset.";
 	}
 }
 
@@ -169,8 +484,10 @@ void BackwardChainer::expand_bit()
 
 	if (_bit.empty()) {
 		_last_expansion_andbit = _bit.init();
-		// Record the initial and-BIT in the trace atomspace
-		_trace_recorder.andbit(*_last_expansion_andbit);
+		// Record the initial and-BITs in the trace atomspace
+		for (const AndBIT& andbit : _bit.andbits)
+			_trace_recorder.andbit(andbit);
+		_init_fulfillment = true;
 	} else {
 		// Select an FCS (i.e. and-BIT) and expand it
 		AndBIT* andbit = select_expansion_andbit();
@@ -183,19 +500,23 @@ void BackwardChainer::expand_bit()
 void BackwardChainer::expand_bit(AndBIT& andbit)
 {
 	// Select leaf
+	Profiler::Timer leaf_timer(_profiler, Profiler::BC_SELECT_LEAF);
 	BITNode* bitleaf = andbit.select_leaf();
+	leaf_timer.stop();
 	if (bitleaf) {
 		LAZY_URE_LOG_DEBUG << "Selected BIT-node for expansion:" << std::endl
 		                   << bitleaf->to_string();
 	} else {
-		ure_logger().debug() << "All BIT-nodes of this and-BIT are exhausted "
-		                     << "(or possibly fulfilled). Abort expansion.";
+		LAZY_URE_LOG_DEBUG << "All BIT-nodes of this and-BIT are exhausted "
+		                   << "(or possibly fulfilled). Abort expansion.";
 		andbit.exhausted = true;
 		return;
 	}
 
 	// Select rule for expansion
+	Profiler::Timer rule_timer(_profiler, Profiler::BC_SELECT_RULE);
 	RuleSelection rule_sel = _control.select_rule(andbit, *bitleaf);
+	rule_timer.stop();
 	Rule rule(rule_sel.first.first);
 	Unify::TypedSubstitution ts(rule_sel.first.second);
 	double prob(rule_sel.second);
@@ -227,7 +548,9 @@ void BackwardChainer::expand_bit(AndBIT& andbit)
 	Handle andbit_fcs = andbit.fcs;
 	Handle bitleaf_body = bitleaf->body;
 	RuleTypedSubstitutionPair rtsp{rule, ts};
+	Profiler::Timer expand_timer(_profiler, Profiler::BC_EXPAND_FCS);
 	_last_expansion_andbit = _bit.expand(andbit, *bitleaf, rtsp, prob);
+	expand_timer.stop();
 
 	// Record the expansion in the trace atomspace
 	if (_last_expansion_andbit) {
@@ -244,11 +567,22 @@ void BackwardChainer::fulfill_bit()
 		return;
 	}
 
+	// Fulfill the initial and-BITs of all targets in one go
+	if (_init_fulfillment) {
+		_init_fulfillment = false;
+		for (const AndBIT& andbit : _bit.andbits) {
+			try {
+				fulfill_fcs(andbit.fcs);
+			} catch (...) {}
+		}
+		return;
+	}
+
 	// Select an and-BIT for fulfillment
 	const AndBIT* andbit = select_fulfillment_andbit();
 	if (andbit == nullptr) {
-		ure_logger().debug() << "Cannot fulfill an empty and-BIT. "
-		                    << "Abort BIT fulfillment";
+		LAZY_URE_LOG_DEBUG << "Cannot fulfill an empty and-BIT. "
+		                  << "Abort BIT fulfillment";
 		return;
 	}
 	LAZY_URE_LOG_DEBUG << "Selected and-BIT for fulfillment (fcs value):"
@@ -263,35 +597,78 @@ void BackwardChainer::fulfill_bit()
 
 void BackwardChainer::fulfill_fcs(const Handle& fcs)
 {
-	// Temporary atomspace to not pollute _as with intermediary
-	// results
-	AtomSpacePtr tmp_as(createAtomSpace(&_kb_as));
-	tmp_as->clear_copy_on_write(); // tmp_as should be write-through.
-
-	// Run the FCS and add the results, if any, in _as.
-	//
-	// Warning: since tmp_as is a child of _as, TVs of existing atoms
-	// in _as, that are modified by running fcs will be modified on
-	// _as as well. This can create involontary TVs changes, hopefully
-	// mitigated by the merging the TVs properly (for now the one with
-	// the highest confidence wins). To avoid that side effect, we
-	// could operate on a copy the atomspace, of its zone of focus. Or
-	// alternatively modify some HypotheticalLink wrapping the atoms
-	// of concerns instead of the atoms themselves, and only modify
-	// the atoms if there are existing results to copy back to _as.
+	Profiler::Timer timer(_profiler, Profiler::BC_FULFILL_FCS);
+
+	// Run the FCS in the scratch atomspace, so that _kb_as is not
+	// polluted with intermediary results. As the scratch atomspace is
+	// copy-on-write, TVs of existing atoms of _kb_as modified while
+	// running the FCS are only modified in the scratch atomspace.
+	// Only the results, along with their TVs, are copied back to
+	// _kb_as. The scratch atomspace is cleared beforehand, rather than
+	// afterward, in case the previous fulfillment has thrown.
 	//
-	// TODO: Maybe we could take advantage of the new read-only
-	// capabilities of the AtomSpace.
-	Handle hresult = HandleCast(fcs->execute(tmp_as.get()));
+	// Under focus, only groundings of premises under focus are
+	// considered, and the results are put under focus.
+	_scratch_as->clear();
+	HandleSeq scratch_results;
+	if (_search_focus_set) {
+		scratch_results = _focus_set->execute(fcs, *_scratch_as);
+	} else {
+		Handle hresult = HandleCast(fcs->execute(_scratch_as.get()));
+		scratch_results = hresult->getOutgoingSet();
+	}
 	HandleSeq results;
-	for (const Handle& result : hresult->getOutgoingSet())
-		results.push_back(_kb_as.add_atom(result));
+	for (const Handle& scratch_result : scratch_results) {
+		// Merge the TVs, the one with the highest confidence wins, so
+		// that a result already in _kb_as keeps its TV if stronger.
+		Handle result = _kb_as.add_atom(scratch_result);
+		TruthValuePtr tv = scratch_result->getTruthValue();
+		if (result->getTruthValue()->get_confidence() < tv->get_confidence())
+			result->setTruthValue(tv);
+		results.push_back(result);
+	}
+	if (_search_focus_set)
+		_focus_set->insert(results);
 	LAZY_URE_LOG_DEBUG << "Results:" << std::endl << results;
-	_results.insert(results.begin(), results.end());
 
-	// Record the results in _trace_as
-	for (const Handle& result : results)
+	// Record the results in _trace_as, then stream them
+	for (const Handle& result : results) {
 		_trace_recorder.proof(fcs, result);
+		insert_result(result);
+	}
+}
+
+void BackwardChainer::insert_result(const Handle& result)
+{
+	if (not _results.insert(result).second)
+		return;
+	_results_seq.push_back(result);
+	route_result(result);
+
+	if (_result_callback)
+		_result_callback(result);
+	if (_stop_predicate and _stop_predicate(result)) {
+		LAZY_URE_LOG_DEBUG << "The following result satisfies the "
+		                   << "stop predicate:" << std::endl
+		                   << oc_to_string(result);
+		_stop_requested = true;
+	}
+}
+
+void BackwardChainer::route_result(const Handle& result)
+{
+	// One-sided match, from the target to the result. The result is
+	// given an empty variable declaration so that its variables, if
+	// any, are treated as constants, then the result is an instance of
+	// the target iff they unify.
+	const HandleSeq& targets = _bit.get_init_targets();
+	const HandleSeq& vardecls = _bit.get_init_vardecls();
+	Handle no_vardecl = HandleCast(createVariableList(HandleSeq()));
+	for (size_t i = 0; i < _target_results.size(); i++) {
+		Unify unify(targets[i], result, vardecls[i], no_vardecl);
+		if (unify().is_satisfiable())
+			_target_results[i].insert(result);
+	}
 }
 
 std::vector<double> BackwardChainer::expansion_andbit_weights()
@@ -304,17 +681,18 @@ std::vector<double> BackwardChainer::expansion_andbit_weights()
 
 AndBIT* BackwardChainer::select_expansion_andbit()
 {
+	Profiler::Timer timer(_profiler, Profiler::BC_SELECT_EXPANSION_ANDBIT);
 	std::vector<double> weights = expansion_andbit_weights();
 
 	// Debug log
-	if (ure_logger().is_debug_enabled()) {
+	if (URE_LOG_ENABLED(DEBUG)) {
 		OC_ASSERT(weights.size() == _bit.andbits.size());
 		std::stringstream ss;
 		ss << "Weighted and-BITs:";
 		for (size_t i = 0; i < weights.size(); i++)
 			ss << std::endl << weights[i] << " "
 			   << _bit.andbits[i].fcs->id_to_string();
-		ure_logger().debug() << ss.str();
+		LAZY_URE_LOG_DEBUG << ss.str();
 	}
 
 	// Sample andbits according to this distribution
@@ -329,6 +707,7 @@ const AndBIT* BackwardChainer::select_fulfillment_andbit() const
 
 void BackwardChainer::reduce_bit()
 {
+	Profiler::Timer timer(_profiler, Profiler::BC_REDUCE_BIT);
 	if (0 < _config.get_max_bit_size()) {
 		// If the BIT size has reached its maximum, randomly remove
 		// and-BITs so that the BIT size gets back below or equal to
@@ -363,14 +742,14 @@ void BackwardChainer::remove_unlikely_expandable_andbit()
 	}
 
 	// Fine log
-	if (ure_logger().is_fine_enabled()) {
+	if (URE_LOG_ENABLED(FINE)) {
 		OC_ASSERT(never_expand_probs.size() == _bit.andbits.size());
 		std::stringstream ss;
 		ss << "Never expand probs and-BITs:";
 		for (size_t i = 0; i < never_expand_probs.size(); i++)
 			ss << std::endl << never_expand_probs[i] << " "
 			   << _bit.andbits[i].fcs->id_to_string();
-		ure_logger().fine() << ss.str();
+		LAZY_URE_LOG_FINE << ss.str();
 	}
 
 	std::discrete_distribution<size_t>
@@ -384,6 +763,20 @@ void BackwardChainer::remove_unlikely_expandable_andbit()
 	_bit.erase(it);
 }
 
+void BackwardChainer::reclaim_bit()
+{
+	if (_bit.get_atoms_count() < _bit_reclaim_size)
+		return;
+
+	size_t removed = _bit.reclaim();
+	size_t remaining = _bit.get_atoms_count();
+	_bit_reclaim_size = std::max(_bit_reclaim_size, 2 * remaining);
+	LAZY_URE_LOG_DEBUG << "Reclaimed " << removed << " atoms from the BIT "
+	                   << "atomspace, " << remaining << " remain ("
+	                   << _bit.get_reclaimed_atoms_count()
+	                   << " reclaimed so far)";
+}
+
 double BackwardChainer::complexity_factor(const AndBIT& andbit) const
 {
 	return exp(-_config.get_complexity_penalty() * andbit.complexity);
@@ -25,8 +25,16 @@
 #ifndef _OPENCOG_BACKWARDCHAINER_H_
 #define _OPENCOG_BACKWARDCHAINER_H_
 
+#include <istream>
+#include <ostream>
+
 #include "../Rule.h"
 #include "../UREConfig.h"
+#include "../Budget.h"
+#include "../CancellationToken.h"
+#include "../FocusSet.h"
+#include "../Utils.h"
+#include "../Profiler.h"
 #include "BIT.h"
 #include "TraceRecorder.h"
 #include "ControlPolicy.h"
@@ -103,7 +111,8 @@ public:
 	 * @param vardecl            Variable declaration of the target
 	 * @param trace_as           Atomspace where to record the trace
 	 * @param control_as         Atomspace containing control rules
-	 * @param focus_set          Focus set (not implemented)
+	 * @param focus_set          Set of atoms, or SetLink thereof, to
+	 *                           which fulfillment is restricted
 	 * @param bitnode_fitness    BITNode fitness function
 	 * @param andbit_fitness     AndBIT (inference tree) fitness function
 	 */
@@ -121,6 +130,54 @@ public:
 	                const BITNodeFitness& bitnode_fitness=BITNodeFitness(),
 	                const AndBITFitness& andbit_fitness=AndBITFitness());
 
+	/**
+	 * Like above, but use an already loaded configuration, copied so
+	 * that modifying it does not affect the given one, and optionally
+	 * already fetched expansion control rules (see
+	 * ControlPolicy). Avoids querying the rule-base and control
+	 * atomspaces for each chainer.
+	 */
+	BackwardChainer(AtomSpace& kb_as,
+	                const UREConfig& config,
+	                const Handle& target,
+	                const Handle& vardecl=Handle::UNDEFINED,
+	                AtomSpace* trace_as=nullptr,
+	                AtomSpace* control_as=nullptr,
+	                const Handle& focus_set=Handle::UNDEFINED,
+	                const BITNodeFitness& bitnode_fitness=BITNodeFitness(),
+	                const AndBITFitness& andbit_fitness=AndBITFitness(),
+	                const ExpansionControlRules* exp_ctrl_rules=nullptr);
+
+	/**
+	 * Like above, but for a batch of targets, queried in one pass. All
+	 * targets share the same BIT, rules and control policy, and their
+	 * initial and-BITs are fulfilled together. Results are available
+	 * per target with get_results(target), each result being credited
+	 * to the targets it is an instance of.
+	 *
+	 * Only identical and-BITs are shared across targets. BIT-nodes are
+	 * owned by their and-BIT, and rules are unified with a leaf under
+	 * the variable declaration of its whole FCS, see
+	 * ControlPolicy::get_valid_rules, so neither BIT-nodes nor
+	 * expansions can be shared across and-BITs of different targets.
+	 * The batch thus saves the setup of one chainer per target, and the
+	 * fulfillment of results common to several targets, not the search
+	 * itself.
+	 *
+	 * vardecls is either empty, or has the same size as targets, with
+	 * possibly undefined variable declarations.
+	 */
+	BackwardChainer(AtomSpace& kb_as,
+	                const UREConfig& config,
+	                const HandleSeq& targets,
+	                const HandleSeq& vardecls=HandleSeq(),
+	                AtomSpace* trace_as=nullptr,
+	                AtomSpace* control_as=nullptr,
+	                const Handle& focus_set=Handle::UNDEFINED,
+	                const BITNodeFitness& bitnode_fitness=BITNodeFitness(),
+	                const AndBITFitness& andbit_fitness=AndBITFitness(),
+	                const ExpansionControlRules* exp_ctrl_rules=nullptr);
+
 	/**
 	 * Like above, but use as rule-base atomspace, the atomspace of rbs
 	 * if any, otherwise use kb_as if rbs has no atomspace.
@@ -138,6 +195,26 @@ public:
 	                const BITNodeFitness& bitnode_fitness=BITNodeFitness(),
 	                const AndBITFitness& andbit_fitness=AndBITFitness());
 
+	/**
+	 * Resume a backward chainer from a checkpoint previously saved by
+	 * save_checkpoint. The remaining arguments must be the same as the
+	 * ones of the chainer that has been saved.
+	 *
+	 * Throw a RuntimeException if the checkpoint is invalid or does
+	 * not correspond to the given target.
+	 */
+	BackwardChainer(std::istream& checkpoint,
+	                AtomSpace& kb_as,
+	                AtomSpace& rb_as,
+	                const Handle& rbs,
+	                const Handle& target,
+	                const Handle& vardecl=Handle::UNDEFINED,
+	                AtomSpace* trace_as=nullptr,
+	                AtomSpace* control_as=nullptr,
+	                const Handle& focus_set=Handle::UNDEFINED,
+	                const BITNodeFitness& bitnode_fitness=BITNodeFitness(),
+	                const AndBITFitness& andbit_fitness=AndBITFitness());
+
 	/**
 	 * URE configuration accessors
 	 */
@@ -159,8 +236,11 @@ public:
 	 * @return true if the termination criteria have been met.
 	 *
 	 * More specifically, either
-	 * 1. reached the maximum number of iterations,
-	 * 2. or all andbits are exhausted.
+	 * 0. chaining has been cancelled,
+	 * 1. a result has satisfied the stop predicate,
+	 * 2. reached the maximum number of iterations,
+	 * 3. exhausted the time or memory budget,
+	 * 4. or all andbits are exhausted.
 	 */
 	bool termination();
 
@@ -171,7 +251,98 @@ public:
 	Handle get_results() const;
 	const HandleSet& get_results_set() const;
 
+	/**
+	 * Get the current results of the given target, one of the batch
+	 * of targets, as a SetLink. Throw a RuntimeException if it is not
+	 * one of the targets.
+	 */
+	Handle get_results(const Handle& target) const;
+
+	/**
+	 * @return the results from position pos onward, in their order of
+	 * production. Starting at 0 and advancing pos by the size of the
+	 * returned sequence allows to consume results as they come.
+	 */
+	HandleSeq get_results_since(size_t pos) const;
+
+	/**
+	 * @return the number of iterations performed so far.
+	 */
+	int get_iteration() const;
+
+	/**
+	 * Profiler counting and timing the phases of the chainer. It is
+	 * enabled by the URE:profile parameter, or can be enabled here
+	 * before chaining. Statistics remain available after chaining.
+	 *
+	 * A timeline can be attached to it as well, to record the
+	 * iterations and phases per thread. If the timeline has a
+	 * filename, it is written at the end of do_chain.
+	 */
+	Profiler& get_profiler();
+	const Profiler& get_profiler() const;
+
+	/**
+	 * Record the back-inference traces in the given trace file as
+	 * well, starting with the targets, or stop doing so if nullptr.
+	 * The file is not closed at the end of chaining, so that the
+	 * traces of several chainings can be appended to it.
+	 */
+	void set_trace_writer(const TraceWriterPtr& writer);
+
+	/**
+	 * Memory metrics of the BIT: number of atoms currently in the BIT
+	 * atomspace, and total number of atoms reclaimed from it.
+	 */
+	size_t get_bit_atoms_count() const;
+	size_t get_reclaimed_bit_atoms_count() const;
+
+	/**
+	 * Set a callback to be called on each new result as soon as it is
+	 * proven.
+	 */
+	void set_result_callback(const ResultCallback& callback);
+
+	/**
+	 * Set a predicate to stop chaining as soon as a new result
+	 * satisfies it. Results proven so far remain available.
+	 */
+	void set_stop_predicate(const ResultPredicate& predicate);
+
+	/**
+	 * Cancel chaining, can be called from any thread. Chaining stops
+	 * at the next step, or before the next rule application, results
+	 * obtained so far remain available.
+	 */
+	void cancel();
+
+	/**
+	 * Set and get the cancellation token. Setting a token, before
+	 * chaining, allows to share it between several chainers, so that
+	 * one call cancels them all.
+	 */
+	void set_cancellation_token(const CancellationTokenPtr& token);
+	const CancellationTokenPtr& get_cancellation_token() const;
+
+	/**
+	 * Return the expansion control rules fetched by the control
+	 * policy, to be passed to subsequent chainers.
+	 */
+	const ExpansionControlRules& get_expansion_control_rules() const;
+
+	/**
+	 * Save the state of the chainer, that is its and-BITs, its
+	 * results and its iteration count, so that chaining can be
+	 * resumed later on with the checkpoint constructor above. Must not
+	 * be called while chaining.
+	 */
+	void save_checkpoint(std::ostream& out) const;
+	void save_checkpoint(const std::string& filename) const;
+
 private:
+	// Restore the state saved by save_checkpoint
+	void load_checkpoint(std::istream& in);
+
 	void expand_meta_rules();
 
 	// Expand the BIT
@@ -188,9 +359,22 @@ private:
 	// strategy.
 	void fulfill_fcs(const Handle& fcs);
 
+	// Insert a result, and if new, pass it to the result callback and
+	// the stop predicate, if any.
+	void insert_result(const Handle& result);
+
+	// Insert a result in the results of the targets it is an instance
+	// of, in case of a batch of targets.
+	void route_result(const Handle& result);
+
 	// Reduce the BIT. Remove some and-BITs.
 	void reduce_bit();
 
+	// Reclaim the atoms of the BIT atomspace no longer used by any
+	// and-BIT, once it has doubled in size since the last time, so
+	// that the cost of reclamation is amortized.
+	void reclaim_bit();
+
 	// Pick up an and-BIT randomly, biased so that this and-BIT is
 	// unlikely to be expanded for the remainder of the inference.
 	void remove_unlikely_expandable_andbit();
@@ -225,9 +409,27 @@ private:
 	// Contain the configuration
 	UREConfig _config;
 
+	// Atoms of _kb_as under focus, including the results obtained so
+	// far. Fulfillment only considers premises under focus.
+	FocusSetPtr _focus_set;
+	bool _search_focus_set;
+
+	// Child atomspace of _kb_as where FCSes are run, recycled from
+	// one fulfillment to the next.
+	AtomSpacePtr _scratch_as;
+
+	// Keep track of the time and memory consumed
+	Budget _budget;
+
+	// Count and time the phases of chaining
+	Profiler _profiler;
+
 	// Structure holding the Back Inference Tree
 	BIT _bit;
 
+	// Size of the BIT atomspace beyond which it is reclaimed
+	size_t _bit_reclaim_size;
+
 	// TODO: perhaps move that under BIT
 	AndBITFitness _andbit_fitness;
 
@@ -247,8 +449,30 @@ private:
 	const AndBIT* _last_expansion_andbit;
 
 	HandleSet _results;
+
+	// Results in their order of production
+	HandleSeq _results_seq;
+
+	// Results per target, in case of a batch of targets, in the same
+	// order as the targets.
+	std::vector<HandleSet> _target_results;
+
+	// True iff the initial and-BITs of all targets are yet to be
+	// fulfilled
+	bool _init_fulfillment;
+
+	// Streaming of results
+	ResultCallback _result_callback;
+	ResultPredicate _stop_predicate;
+
+	// Set when a result has satisfied the stop predicate
+	bool _stop_requested;
+
+	// Set to cancel chaining
+	CancellationTokenPtr _cancellation_token;
 };
 
+typedef std::shared_ptr<BackwardChainer> BackwardChainerPtr;
 
 } // namespace opencog
 
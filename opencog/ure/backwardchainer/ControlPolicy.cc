@@ -23,6 +23,11 @@
 
 #include "ControlPolicy.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <boost/algorithm/cxx11/any_of.hpp>
+
 #include <opencog/util/random.h>
 #include <opencog/util/algorithm.h>
 #include <opencog/unify/Unify.h>
@@ -41,40 +46,68 @@ using namespace opencog;
 #define an _query_as->add_node
 
 ControlPolicy::ControlPolicy(const UREConfig& ure_config, const BIT& bit,
-                             const Handle& target, AtomSpace* control_as) :
+                             const Handle& target, AtomSpace* control_as,
+                             const ExpansionControlRules* exp_ctrl_rules) :
+	ControlPolicy(ure_config, bit, HandleSeq{target}, control_as,
+	              exp_ctrl_rules)
+{
+}
+
+ControlPolicy::ControlPolicy(const UREConfig& ure_config, const BIT& bit,
+                             const HandleSeq& targets, AtomSpace* control_as,
+                             const ExpansionControlRules* exp_ctrl_rules) :
 	rules(ure_config.get_rules()), _ure_config(ure_config),
-	_bit(bit), _target(target), _control_as(control_as), _query_as(nullptr)
+	_bit(bit), _targets(targets), _control_as(control_as), _query_as(nullptr),
+	_mixture_cpx_penalty(std::numeric_limits<double>::quiet_NaN()),
+	_mixture_compressiveness(std::numeric_limits<double>::quiet_NaN())
 {
 	// Fetch default TVs for each inference rule (the TV on the member
 	// link connecting the rule to the rule base)
 	for (RulePtr rule : rules) {
 		_default_tvs[rule->get_alias()] = rule->get_tv();
 	}
-	std::stringstream ss;
-	ss << "Default inference rule TVs:";
-	for (const auto& rtv : _default_tvs)
-		ss << std::endl << rtv.second->to_string() << " " << oc_to_string(rtv.first);
-	ure_logger().debug() << ss.str();
-
-	// Fetches expansion control rules from _control_as
-	if (_control_as) {
+	if (URE_LOG_ENABLED(DEBUG)) {
+		std::stringstream ss;
+		ss << "Default inference rule TVs:";
+		for (const auto& rtv : _default_tvs)
+			ss << std::endl << rtv.second->to_string() << " " << oc_to_string(rtv.first);
+		ure_logger().debug() << ss.str();
+	}
+
+	// Reuse the given expansion control rules, if any, otherwise
+	// fetches expansion control rules from _control_as
+	if (_control_as and exp_ctrl_rules) {
+		_expansion_control_rules = *exp_ctrl_rules;
+	} else if (_control_as) {
 		_query_as = createAtomSpace(_control_as);
 		_query_as->clear_copy_on_write(); // _as should be write-through.
 		for (const Handle& rule_alias : rules.aliases()) {
 			HandleSet exp_ctrl_rules = fetch_expansion_control_rules(rule_alias);
 			_expansion_control_rules[rule_alias] = exp_ctrl_rules;
 
-			ure_logger().debug() << "Expansion control rules for "
-			                     << rule_alias->to_string()
-			                     << oc_to_string(exp_ctrl_rules);
+			LAZY_URE_LOG_DEBUG << "Expansion control rules for "
+			                   << rule_alias->to_string()
+			                   << oc_to_string(exp_ctrl_rules);
 		}
 	}
+
+	// Precalculate the statistics of the control rules involved in
+	// mixture models
+	for (const auto& rule_ctrl_rules : _expansion_control_rules)
+		for (const Handle& ctrl_rule : rule_ctrl_rules.second)
+			if (_ctrl_rule_stats.find(ctrl_rule) == _ctrl_rule_stats.end())
+				_ctrl_rule_stats[ctrl_rule] = MixtureModel::model_stats(ctrl_rule);
 }
 
 ControlPolicy::~ControlPolicy()
 {
 }
 
+const ExpansionControlRules& ControlPolicy::get_expansion_control_rules() const
+{
+	return _expansion_control_rules;
+}
+
 RuleSelection ControlPolicy::select_rule(AndBIT& andbit, BITNode& bitleaf)
 {
 	// The rule is randomly selected amongst the valid ones, with
@@ -86,7 +119,7 @@ RuleSelection ControlPolicy::select_rule(AndBIT& andbit, BITNode& bitleaf)
 	}
 
 	// Log all valid rules
-	if (ure_logger().is_debug_enabled()) {
+	if (URE_LOG_ENABLED(DEBUG)) {
 		std::stringstream ss;
 		ss << "The following rules are valid:" << std::endl
 		   << oc_to_string(rule_aliases(valid_rules));
@@ -176,24 +209,48 @@ HandleTVMap ControlPolicy::expansion_success_tvs(
 		} else {
 			// Otherwise calculate the truth value of its mixture
 			// model.
-			double cpx_penalty = _ure_config.get_mm_complexity_penalty(),
-				compressiveness = _ure_config.get_mm_compressiveness();
-			success_tvs[rule] = MixtureModel(active_ctrl_rules,
-			                                 cpx_penalty, compressiveness)();
+			success_tvs[rule] = mixture_tv(active_ctrl_rules);
 		}
 	}
 
 	// Log TVs of representing probability of success (expanding into
 	// a preproof) for each action
-	std::stringstream ss;
-	ss << "Rule TVs of expanding a preproof into another preproof:" << std::endl;
-	for (const auto& rtv : success_tvs)
-		ss << rtv.second->to_string() << " " << oc_to_string(rtv.first);
-	ure_logger().debug() << ss.str();
+	if (URE_LOG_ENABLED(DEBUG)) {
+		std::stringstream ss;
+		ss << "Rule TVs of expanding a preproof into another preproof:" << std::endl;
+		for (const auto& rtv : success_tvs)
+			ss << rtv.second->to_string() << " " << oc_to_string(rtv.first);
+		ure_logger().debug() << ss.str();
+	}
 
 	return success_tvs;
 }
 
+TruthValuePtr ControlPolicy::mixture_tv(const HandleSet& active_ctrl_rules)
+{
+	double cpx_penalty = _ure_config.get_mm_complexity_penalty(),
+		compressiveness = _ure_config.get_mm_compressiveness();
+
+	// Forget the memoized TVs if the parameters have changed
+	if (cpx_penalty != _mixture_cpx_penalty
+	    or compressiveness != _mixture_compressiveness) {
+		_mixture_tvs.clear();
+		_mixture_cpx_penalty = cpx_penalty;
+		_mixture_compressiveness = compressiveness;
+	}
+
+	HandleSeq key(active_ctrl_rules.begin(), active_ctrl_rules.end());
+	std::sort(key.begin(), key.end());
+	auto it = _mixture_tvs.find(key);
+	if (it != _mixture_tvs.end())
+		return it->second;
+
+	TruthValuePtr tv = MixtureModel(active_ctrl_rules, _ctrl_rule_stats,
+	                                cpx_penalty, compressiveness)();
+	_mixture_tvs.emplace(std::move(key), tv);
+	return tv;
+}
+
 std::vector<double> ControlPolicy::rule_weights(const HandleTVMap& success_tvs,
                                                 const RuleTypedSubstitutionMap& inf_rules)
 {
@@ -204,11 +261,13 @@ std::vector<double> ControlPolicy::rule_weights(const HandleTVMap& success_tvs,
 	HandleCounter alias_weights = action_selection.distribution();
 
 	// Log rule weights for action selection
-	std::stringstream ssw;
-	ssw << "Rule weights:" << std::endl;
-	for (const auto& rw : alias_weights)
-		ssw << rw.second << " " << oc_to_string(rw.first);
-	ure_logger().debug() << ssw.str();
+	if (URE_LOG_ENABLED(DEBUG)) {
+		std::stringstream ssw;
+		ssw << "Rule weights:" << std::endl;
+		for (const auto& rw : alias_weights)
+			ssw << rw.second << " " << oc_to_string(rw.first);
+		ure_logger().debug() << ssw.str();
+	}
 
 	// Reweight over rule instances and normalize
 	rule_weights(alias_weights, inf_rules);
@@ -251,7 +310,7 @@ HandleSet ControlPolicy::active_expansion_control_rules(
 			results.insert(ctrl_rule);
 
 	// Log active control rules, if any
-	if (not results.empty()) {
+	if (not results.empty() and URE_LOG_ENABLED(DEBUG)) {
 		std::stringstream ss;
 		ss << "Active expansion control rules for "
 		   << inf_rule_alias->to_string()
@@ -306,10 +365,12 @@ bool ControlPolicy::is_control_rule_active(const AndBIT& andbit,
 	}
 
 	// Check that
-	// 1. the control target matches the actual target
+	// 1. the control target matches one of the actual targets
 	// 2. the control andbit matches the actual andbit
 	// 3. the control bitleaf matches the actual bitleaf
-	return match(ctrl_target, _target, ctrl_vardecl)
+	auto match_target = [&](const Handle& target) {
+		return match(ctrl_target, target, ctrl_vardecl); };
+	return boost::algorithm::any_of(_targets, match_target)
 		and match(ctrl_andbit, nexe_actl_andbit, ctrl_vardecl)
 		and match(ctrl_bitleaf, actl_bitleaf, ctrl_vardecl);
 }
@@ -28,6 +28,7 @@
 #include "BIT.h"
 #include "../UREConfig.h"
 #include "../Rule.h"
+#include "../MixtureModel.h"
 
 class ControlPolicyUTest;
 
@@ -44,12 +45,30 @@ typedef std::map<Handle, TruthValuePtr> HandleTVMap;
 // TODO: maybe wrap that in a class, and use it in foward chainer
 typedef std::pair<RuleTypedSubstitutionPair, double> RuleSelection;
 
+// Map each inference rule alias to its expansion control rules
+typedef std::map<Handle, HandleSet> ExpansionControlRules;
+
 class ControlPolicy
 {
 	friend class ::ControlPolicyUTest;
 public:
+	/**
+	 * Ctor. If exp_ctrl_rules is provided then it is used instead of
+	 * fetching the expansion control rules from control_as, which is
+	 * expensive. Meant to be used with the expansion control rules of
+	 * a previous control policy over the same rules and control_as.
+	 */
+	ControlPolicy(const UREConfig& ure_config, const BIT& bit,
+	              const Handle& target, AtomSpace* control_as=nullptr,
+	              const ExpansionControlRules* exp_ctrl_rules=nullptr);
+
+	/**
+	 * Like above, but for a batch of targets. A control rule is
+	 * active if its target matches any of them.
+	 */
 	ControlPolicy(const UREConfig& ure_config, const BIT& bit,
-	              const Handle& target, AtomSpace* control_as=nullptr);
+	              const HandleSeq& targets, AtomSpace* control_as=nullptr,
+	              const ExpansionControlRules* exp_ctrl_rules=nullptr);
 	~ControlPolicy();
 
 	const std::string preproof_predicate_name = "URE:BC:preproof-of";
@@ -81,6 +100,11 @@ public:
 	 */
 	static HandleSet rule_aliases(const RuleTypedSubstitutionMap& rules);
 
+	/**
+	 * Return the expansion control rules of each inference rule.
+	 */
+	const ExpansionControlRules& get_expansion_control_rules() const;
+
 private:
 	// Reference to URE configuration
 	const UREConfig& _ure_config;
@@ -89,7 +113,7 @@ private:
 	const BIT& _bit;
 
 	// Target
-	const Handle& _target;
+	const HandleSeq _targets;
 
 	// Map alias rule to their default TV. This is used whenever no
 	// control rule can be used to predict inference expansion.
@@ -112,7 +136,25 @@ private:
 
 	// Map each action (inference rule expansion) to the set of
 	// control rules involving it.
-	std::map<Handle, HandleSet> _expansion_control_rules;
+	ExpansionControlRules _expansion_control_rules;
+
+	// Statistics of each expansion control rule, calculated once at
+	// construction since control rules do not change during
+	// chaining.
+	MixtureModel::ModelStatsMap _ctrl_rule_stats;
+
+	// Mixture TVs of the sets of active control rules encountered so
+	// far, each set being sorted, and the mixture parameters they
+	// have been calculated with.
+	std::map<HandleSeq, TruthValuePtr> _mixture_tvs;
+	double _mixture_cpx_penalty;
+	double _mixture_compressiveness;
+
+	/**
+	 * Return the TV of the mixture model of the given active control
+	 * rules, memoized in _mixture_tvs.
+	 */
+	TruthValuePtr mixture_tv(const HandleSet& active_ctrl_rules);
 
 	/**
 	 * Return all valid inference rules, in the sense that they may
@@ -41,32 +41,61 @@ TraceRecorder::TraceRecorder(AtomSpace* tr_as) : _trace_as(tr_as) {
 			_trace_as->add_node(SCHEMA_NODE, std::move(std::string(expand_andbit_schema_name)));
 		_proof_predicate =
 			_trace_as->add_node(PREDICATE_NODE, std::move(std::string(proof_predicate_name)));
+
+		// Index the traces already in _trace_as, if any
+		for (const Handle& exec_link :
+			     _expand_andbit_schema->getIncomingSetByType(EXECUTION_LINK))
+			_expansion_sources[exec_link->getOutgoingAtom(2)].insert(
+				exec_link->getOutgoingAtom(1)->getOutgoingAtom(0));
+		for (const Handle& eval_link :
+			     _proof_predicate->getIncomingSetByType(EVALUATION_LINK))
+			_fcs_proofs.insert(eval_link->getOutgoingAtom(1)->getOutgoingAtom(0));
 	}
 }
 
+void TraceRecorder::set_writer(const TraceWriterPtr& writer)
+{
+	_writer = writer;
+}
+
 HandleSeqSet TraceRecorder::traces()
 {
 	HandleSeqSet trs;
+	TracesMemo memo;
 	for (const Handle& fcs_proof : get_fcs_proofs())
-		set_union_modify(trs, traces(fcs_proof));
+		set_union_modify(trs, traces(fcs_proof, memo));
 	return trs;
 }
 
 HandleSeqSet TraceRecorder::traces(const Handle& fcs)
 {
-	HandleSet expansion_sources(get_expansion_sources(fcs));
+	TracesMemo memo;
+	return traces(fcs, memo);
+}
+
+const HandleSeqSet& TraceRecorder::traces(const Handle& fcs, TracesMemo& memo)
+{
+	// Already visited. The entry is inserted before visiting the
+	// ancestors, thus a cycle, if any, is cut there.
+	auto it = memo.find(fcs);
+	if (it != memo.end())
+		return it->second;
+	HandleSeqSet& trs = memo[fcs];
+
+	const HandleSet& expansion_sources = get_expansion_sources(fcs);
 
 	// Unwrap DontExecLink around the fcs
 	Handle exec_fcs = fcs->getOutgoingAtom(0);
 
 	// Base case
-	if (expansion_sources.empty())
-		return HandleSeqSet{{exec_fcs}};
+	if (expansion_sources.empty()) {
+		trs.insert({exec_fcs});
+		return trs;
+	}
 
 	// Recursive case
-	HandleSeqSet trs;
 	for (const Handle& h : expansion_sources) {
-		for (HandleSeq hs : traces(h)) {
+		for (HandleSeq hs : traces(h, memo)) {
 			hs.push_back(exec_fcs);
 			trs.insert(hs);
 		}
@@ -76,30 +105,61 @@ HandleSeqSet TraceRecorder::traces(const Handle& fcs)
 
 void TraceRecorder::target(const Handle& target)
 {
+	if (_writer)
+		_writer->target(target);
 	add_evaluation(_target_predicate, target, TruthValue::TRUE_TV());
 }
 
 void TraceRecorder::andbit(const AndBIT& andbit)
 {
+	this->andbit(andbit.fcs);
+}
+
+void TraceRecorder::andbit(const Handle& andbit_fcs)
+{
+	if (_writer)
+		_writer->andbit(andbit_fcs);
 	add_evaluation(_andbit_predicate,
-	               dont_exec(andbit.fcs),
+	               dont_exec(andbit_fcs),
 	               TruthValue::TRUE_TV());
 }
 
 void TraceRecorder::expansion(const Handle& andbit_fcs, const Handle& bitleaf_body,
                               const Rule& rule, const AndBIT& new_andbit)
 {
+	expansion(andbit_fcs, bitleaf_body, rule.get_alias(), new_andbit.fcs);
+}
+
+void TraceRecorder::expansion(const Handle& andbit_fcs, const Handle& bitleaf_body,
+                              const Handle& rule_alias,
+                              const Handle& new_andbit_fcs)
+{
+	if (_writer)
+		_writer->expansion(andbit_fcs, bitleaf_body, rule_alias,
+		                   new_andbit_fcs);
+	if (not _trace_as)
+		return;
+
+	Handle source = dont_exec(andbit_fcs), target = dont_exec(new_andbit_fcs);
 	add_execution(_expand_andbit_schema,
-	              dont_exec(andbit_fcs), bitleaf_body,
-	              dont_exec(rule.get_alias()),
-	              dont_exec(new_andbit.fcs), TruthValue::TRUE_TV());
+	              source, bitleaf_body,
+	              dont_exec(rule_alias),
+	              target, TruthValue::TRUE_TV());
+	_expansion_sources[target].insert(source);
 }
 
 void TraceRecorder::proof(const Handle& andbit_fcs, const Handle& target_result)
 {
+	if (_writer)
+		_writer->proof(andbit_fcs, target_result);
+	if (not _trace_as)
+		return;
+
+	Handle fcs = dont_exec(andbit_fcs);
 	add_evaluation(_proof_predicate,
-	               dont_exec(andbit_fcs), target_result,
+	               fcs, target_result,
 	               target_result->getTruthValue());
+	_fcs_proofs.insert(fcs);
 }
 
 Handle TraceRecorder::dont_exec(const Handle& h)
@@ -159,19 +219,14 @@ Handle TraceRecorder::add_evaluation(const Handle& predicate,
 	return add_evaluation(predicate, arguments, tv);
 }
 
-HandleSet TraceRecorder::get_expansion_sources(const Handle& fcs_target)
+const HandleSet& TraceRecorder::get_expansion_sources(const Handle& fcs_target) const
 {
-	HandleSet sources;
-	for (auto& exec_link : fcs_target->getIncomingSetByType(EXECUTION_LINK))
-		if (exec_link->getOutgoingAtom(0) == _expand_andbit_schema)
-			sources.insert(exec_link->getOutgoingAtom(1)->getOutgoingAtom(0));
-	return sources;
+	static const HandleSet empty;
+	auto it = _expansion_sources.find(fcs_target);
+	return it != _expansion_sources.end() ? it->second : empty;
 }
 
-HandleSet TraceRecorder::get_fcs_proofs()
+const HandleSet& TraceRecorder::get_fcs_proofs() const
 {
-	HandleSet fcs_proofs;
-	for (auto& eval_link : _proof_predicate->getIncomingSetByType(EVALUATION_LINK))
-		fcs_proofs.insert(eval_link->getOutgoingAtom(1)->getOutgoingAtom(0));
-	return fcs_proofs;
+	return _fcs_proofs;
 }
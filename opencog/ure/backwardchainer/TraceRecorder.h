@@ -23,10 +23,13 @@
 #ifndef _OPENCOG_TRACERECORDER_H_
 #define _OPENCOG_TRACERECORDER_H_
 
+#include <unordered_map>
+
 #include <opencog/atomspace/AtomSpace.h>
 
 #include "BIT.h"
 #include "../Rule.h"
+#include "../TraceFile.h"
 
 namespace opencog
 {
@@ -41,7 +44,13 @@ public:
 
 	TraceRecorder(AtomSpace* tr_as);
 
-	// Return the traces of fcs leading to the recorded proofs
+	// Also record the traces in the given trace file, or stop doing
+	// so if nullptr. Either the trace atomspace or the trace file, or
+	// both, may be used.
+	void set_writer(const TraceWriterPtr& writer);
+
+	// Return the traces of fcs leading to the recorded proofs. Each
+	// fcs is only visited once, across all proofs.
 	HandleSeqSet traces();
 
 	// Return traces leading to the given FCS. A trace is a sequence
@@ -62,6 +71,7 @@ public:
 	//   Predicate "URE:BC:and-BIT"
 	//   <and-BIT>
 	void andbit(const AndBIT& andbit);
+	void andbit(const Handle& andbit_fcs);
 
 	// Record and-BIT expansion to _trace_as
 	//
@@ -78,6 +88,8 @@ public:
 	// handles).
 	void expansion(const Handle& andbit_fcs, const Handle& bitleaf_body,
 	               const Rule& rule, const AndBIT& new_andbit);
+	void expansion(const Handle& andbit_fcs, const Handle& bitleaf_body,
+	               const Handle& rule_alias, const Handle& new_andbit_fcs);
 
 	// Record whether a certain and-BIT is a proof of a certain target result
 	//
@@ -99,9 +111,25 @@ public:
 private:
 	AtomSpace* _trace_as;
 
+	TraceWriterPtr _writer;
+
 	Handle _target_predicate, _andbit_predicate, _expand_andbit_schema,
 		_proof_predicate;
 
+	// Index of the expansions and proofs recorded in _trace_as, so
+	// that traces are extracted without querying it. Map each fcs,
+	// wrapped in a DontExecLink, to the fcs it has been expanded
+	// from, and hold the fcs of the proofs.
+	std::unordered_map<Handle, HandleSet> _expansion_sources;
+	HandleSet _fcs_proofs;
+
+	// Memoized traces of each fcs visited so far
+	typedef std::unordered_map<Handle, HandleSeqSet> TracesMemo;
+
+	// Like traces(fcs) but memoize the traces of fcs and its
+	// ancestors in memo, so that they are built only once.
+	const HandleSeqSet& traces(const Handle& fcs, TracesMemo& memo);
+
 	// Wrap a DontExecLink around h
 	//
 	// DontExecLink
@@ -155,10 +183,10 @@ private:
 	                      TruthValuePtr tv);
 
 	// Given a fcs, return all fcs that expands to this fcs target.
-	HandleSet get_expansion_sources(const Handle& fcs_target);
+	const HandleSet& get_expansion_sources(const Handle& fcs_target) const;
 
 	// Return the set of fcs corresponding to proofs
-	HandleSet get_fcs_proofs();
+	const HandleSet& get_fcs_proofs() const;
 };
 
 
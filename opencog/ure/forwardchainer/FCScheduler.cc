@@ -0,0 +1,132 @@
+/*
+ * FCScheduler.cc
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include "FCScheduler.h"
+#include "../URELogger.h"
+
+using namespace opencog;
+
+FCScheduler::FCScheduler(AtomSpace& kb_as,
+                         const UREConfig& config,
+                         const HandleSeq& focus_set)
+	: _kb_as(kb_as),
+	  _config(config),
+	  _running(0),
+	  _cancellation_token(createCancellationToken())
+{
+	if (not focus_set.empty()) {
+		_focus_set = createFocusSet();
+		_focus_set_as = createAtomSpace(&_kb_as);
+		for (const Handle& h : focus_set)
+			_focus_set->insert(_focus_set_as->add_atom(h));
+	}
+}
+
+ForwardChainerPtr FCScheduler::add_job(const Handle& source,
+                                       const Handle& vardecl,
+                                       AtomSpace* trace_as)
+{
+	ForwardChainerPtr fc =
+		std::make_shared<ForwardChainer>(_kb_as, _config, source, vardecl,
+		                                 trace_as);
+	if (_focus_set)
+		fc->set_focus_set(_focus_set, _focus_set_as);
+	fc->set_cancellation_token(_cancellation_token);
+	_jobs.push_back(fc);
+	return fc;
+}
+
+const std::vector<ForwardChainerPtr>& FCScheduler::get_jobs() const
+{
+	return _jobs;
+}
+
+void FCScheduler::run(int workers)
+{
+	if (workers < 0)
+		workers = _config.get_jobs();
+	workers = std::max(1, std::min(workers, (int)_jobs.size()));
+
+	LAZY_URE_LOG_DEBUG << "Run " << _jobs.size() << " forward chaining jobs"
+	                   << " with " << workers << " workers";
+
+	_queue.clear();
+	_running = 0;
+	for (size_t i = 0; i < _jobs.size(); i++)
+		if (not _jobs[i]->termination())
+			_queue.push_back(i);
+
+	if (workers == 1) {
+		work();
+		return;
+	}
+
+	// Set log thread ID as it is multi-threaded
+	bool prev_thread_id = ure_logger().get_thread_id_flag();
+	ure_logger().set_thread_id_flag(true);
+
+	std::vector<std::thread> pool;
+	for (int i = 0; i < workers; i++)
+		pool.emplace_back(&FCScheduler::work, this);
+	for (std::thread& thrd : pool)
+		thrd.join();
+
+	// Restore logging thread ID flag
+	ure_logger().set_thread_id_flag(prev_thread_id);
+}
+
+void FCScheduler::cancel()
+{
+	_cancellation_token->cancel();
+}
+
+void FCScheduler::work()
+{
+	std::unique_lock<std::mutex> lock(_queue_mutex);
+	while (true) {
+		// Wait for a job to step, unless none is left, in which case
+		// there is nothing more to wait for.
+		_queue_cv.wait(lock, [&]() { return not _queue.empty()
+		                                    or _running == 0; });
+		if (_queue.empty())
+			break;
+
+		size_t i = _queue.front();
+		_queue.pop_front();
+		_running++;
+		lock.unlock();
+
+		ForwardChainer& fc = *_jobs[i];
+		fc.do_step();
+		bool terminated = fc.termination();
+		if (terminated)
+			fc.termination_log();
+
+		lock.lock();
+		_running--;
+		if (not terminated)
+			_queue.push_back(i);
+		_queue_cv.notify_all();
+	}
+}
@@ -0,0 +1,132 @@
+/*
+ * FCScheduler.h
+ *
+ * Copyright (C) 2020 SingularityNET Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_FCSCHEDULER_H_
+#define _OPENCOG_FCSCHEDULER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "../UREConfig.h"
+#include "../CancellationToken.h"
+#include "../FocusSet.h"
+#include "ForwardChainer.h"
+
+class ForwardChainerUTest;
+
+namespace opencog
+{
+
+/**
+ * Run many independent forward chaining jobs over the same
+ * knowledge-base and rule-based system. The configuration is loaded
+ * once, then copied by each job, rules included, as these hold
+ * per-job state. The focus set, if any, is shared by all jobs.
+ *
+ * The iterations of the jobs are interleaved on a pool of worker
+ * threads. A job is stepped by one worker at a time, and after each
+ * step goes to the back of the queue, so that jobs progress in a
+ * round-robin fashion, while no worker idles as long as there are
+ * more pending jobs than workers.
+ *
+ * Each job is a forward chainer with its own copy of the
+ * configuration, thus its own termination criteria and budget, and
+ * its own result stream, see ForwardChainer::set_result_callback.
+ */
+class FCScheduler
+{
+public:
+	/**
+	 * @param kb_as     Knowledge-base atomspace
+	 * @param config    Configuration of the jobs
+	 * @param focus_set Set of atoms under focus, shared by all jobs.
+	 *                  Note that the atoms produced by a job are then
+	 *                  visible to the other jobs.
+	 */
+	FCScheduler(AtomSpace& kb_as,
+	            const UREConfig& config,
+	            const HandleSeq& focus_set=HandleSeq());
+
+	/**
+	 * Add a job, see ForwardChainer for the description of the
+	 * arguments. The returned chainer can be used to set its
+	 * configuration and result callback before running.
+	 */
+	ForwardChainerPtr add_job(const Handle& source,
+	                          const Handle& vardecl=Handle::UNDEFINED,
+	                          AtomSpace* trace_as=nullptr);
+
+	/**
+	 * Return the jobs in their order of addition.
+	 */
+	const std::vector<ForwardChainerPtr>& get_jobs() const;
+
+	/**
+	 * Run all jobs till they terminate, using the given number of
+	 * workers, or the number of jobs of the configuration if
+	 * negative. There is no point in having more workers than jobs.
+	 */
+	void run(int workers=-1);
+
+	/**
+	 * Cancel all jobs, can be called from any thread.
+	 */
+	void cancel();
+
+private:
+	friend class ::ForwardChainerUTest;
+
+	/**
+	 * Step jobs taken from the queue till all have terminated.
+	 */
+	void work();
+
+	AtomSpace& _kb_as;
+
+	UREConfig _config;
+
+	// Focus set shared by all jobs, if any, and the atomspace
+	// holding their products
+	FocusSetPtr _focus_set;
+	AtomSpacePtr _focus_set_as;
+
+	std::vector<ForwardChainerPtr> _jobs;
+
+	// Indices of the jobs waiting to be stepped, in round-robin order
+	std::deque<size_t> _queue;
+
+	// Number of jobs currently being stepped
+	size_t _running;
+
+	std::mutex _queue_mutex;
+	std::condition_variable _queue_cv;
+
+	// Shared by all jobs so that one call cancels them all
+	CancellationTokenPtr _cancellation_token;
+};
+
+typedef std::shared_ptr<FCScheduler> FCSchedulerPtr;
+#define createFCScheduler std::make_shared<FCScheduler>
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_FCSCHEDULER_H_ */
@@ -21,36 +21,118 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "FCStat.h"
 #include <opencog/atoms/core/NumberNode.h>
 
 using namespace opencog;
 
-void FCStat::add_inference_record(unsigned iteration, Handle source,
-                                  const Rule& rule,
+void FCStat::set_writer(const TraceWriterPtr& writer)
+{
+	_writer = writer;
+}
+
+void FCStat::add_inference_record(unsigned iteration, const Handle& source,
+                                  const RulePtr& rule,
                                   const HandleSet& product)
 {
 	{
-		std::lock_guard<std::mutex> lock(_whole_mutex);
-		_inf_rec.emplace_back(source, rule, product);
+		ThreadLog& tlog = thread_log();
+		std::lock_guard<std::mutex> lock(tlog.mutex);
+		tlog.records.emplace_back(iteration, source, rule, product);
+		tlog.pending_products.insert(tlog.pending_products.end(),
+		                             product.begin(), product.end());
 	}
 
-	if (_trace_as and not product.empty()) {
-		Handle schema = rule.get_alias();
-		Handle i = _trace_as->add_node(NUMBER_NODE, std::to_string(iteration + 1));
-		Handle inputs = _trace_as->add_link(LIST_LINK, source, i);
-		for (const Handle& output : product) {
-			_trace_as->add_link(EXECUTION_LINK, schema, inputs, output);
-		}
+	if (product.empty())
+		return;
+	if (_writer)
+		_writer->inference(iteration, source, rule->get_alias(), product);
+	if (_trace_as)
+		trace(_trace_as, iteration, source, rule->get_alias(), product);
+}
+
+void FCStat::trace(AtomSpace* trace_as, unsigned iteration,
+                   const Handle& source, const Handle& rule_alias,
+                   const HandleSet& product)
+{
+	Handle i = trace_as->add_node(NUMBER_NODE, std::to_string(iteration + 1));
+	Handle inputs = trace_as->add_link(LIST_LINK, source, i);
+	for (const Handle& output : product) {
+		trace_as->add_link(EXECUTION_LINK, rule_alias, inputs, output);
 	}
 }
 
 HandleSet FCStat::get_all_products() const
 {
-	std::lock_guard<std::mutex> lock(_whole_mutex);
-	HandleSet all;
-	for(const auto& ir : _inf_rec)
-		all.insert(ir.product.begin(),ir.product.end());
+	collect_products();
+	std::lock_guard<std::mutex> lock(_products_mutex);
+	return _products;
+}
+
+size_t FCStat::products_size() const
+{
+	collect_products();
+	std::lock_guard<std::mutex> lock(_products_mutex);
+	return _products.size();
+}
+
+HandleSeq FCStat::get_products_since(size_t pos) const
+{
+	collect_products();
+	std::lock_guard<std::mutex> lock(_products_mutex);
+	if (_products_seq.size() <= pos)
+		return {};
+	return HandleSeq(std::next(_products_seq.begin(), pos), _products_seq.end());
+}
 
+InferenceRecordSeq FCStat::get_inference_records() const
+{
+	InferenceRecordSeq all;
+	{
+		std::shared_lock<std::shared_mutex> lock(_thread_logs_mutex);
+		for (const auto& tl : _thread_logs) {
+			std::lock_guard<std::mutex> tlock(tl.second->mutex);
+			all.insert(all.end(), tl.second->records.begin(),
+			           tl.second->records.end());
+		}
+	}
+	std::stable_sort(all.begin(), all.end(),
+	                 [](const InferenceRecord& l, const InferenceRecord& r) {
+		                 return l.iteration < r.iteration; });
 	return all;
 }
+
+FCStat::ThreadLog& FCStat::thread_log()
+{
+	std::thread::id tid = std::this_thread::get_id();
+	{
+		std::shared_lock<std::shared_mutex> lock(_thread_logs_mutex);
+		auto it = _thread_logs.find(tid);
+		if (it != _thread_logs.end())
+			return *it->second;
+	}
+	// First record of that thread, register its log
+	std::unique_lock<std::shared_mutex> lock(_thread_logs_mutex);
+	ThreadLogPtr& tlog = _thread_logs[tid];
+	if (not tlog)
+		tlog = std::make_shared<ThreadLog>();
+	return *tlog;
+}
+
+void FCStat::collect_products() const
+{
+	std::lock_guard<std::mutex> plock(_products_mutex);
+	std::shared_lock<std::shared_mutex> lock(_thread_logs_mutex);
+	for (const auto& tl : _thread_logs) {
+		HandleSeq pending;
+		{
+			std::lock_guard<std::mutex> tlock(tl.second->mutex);
+			pending.swap(tl.second->pending_products);
+		}
+		for (const Handle& h : pending)
+			if (_products.insert(h).second)
+				_products_seq.push_back(h);
+	}
+}
@@ -24,28 +24,48 @@
 #ifndef _OPENCOG_FCSTAT_H_
 #define _OPENCOG_FCSTAT_H_
 
-#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
 
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/ure/Rule.h>
+#include <opencog/ure/TraceFile.h>
+
+class ForwardChainerUTest;
 
 namespace opencog {
 
 struct InferenceRecord
 {
-	const Handle hsource;
-	const Rule& rule;
+	unsigned iteration;
+	Handle hsource;
+	// Hold a pointer rather than a reference, as the rule may be
+	// deallocated by the source set (see SourceSet::reset_exhausted)
+	// while the record is still alive.
+	RulePtr rule;
 	HandleSet product;
 
-	InferenceRecord(Handle h, const Rule& r, const HandleSet& p)
-		: hsource(h), rule(r), product(p) {}
+	InferenceRecord(unsigned i, const Handle& h, const RulePtr& r,
+	                const HandleSet& p)
+		: iteration(i), hsource(h), rule(r), product(p) {}
 };
 
+typedef std::vector<InferenceRecord> InferenceRecordSeq;
+
 class FCStat
 {
 public:
 	FCStat(AtomSpace* trace_as) : _trace_as(trace_as) {}
 
+	/**
+	 * Also record the inference steps in the given trace file, or
+	 * stop doing so if nullptr.
+	 */
+	void set_writer(const TraceWriterPtr& writer);
+
 	/**
 	 * Record the inference step into memory, as well as in the
 	 * atomspace according to the following format:
@@ -63,18 +83,78 @@ public:
 	 * 2. <step> is NumberNode <#iteration>
 	 * 3. <source> is the source
 	 * 4. <product> is a SetLink <p1> ... <pn> where pi are the products
+	 *
+	 * Records are appended to a buffer owned by the calling thread,
+	 * thus concurrent workers do not contend with each other.
+	 */
+	void add_inference_record(unsigned iteration, const Handle& source,
+	                          const RulePtr& rule, const HandleSet& product);
+
+	/**
+	 * Record the inference step in trace_as, according to the format
+	 * above, rule_alias being <rule>.
+	 */
+	static void trace(AtomSpace* trace_as, unsigned iteration,
+	                  const Handle& source, const Handle& rule_alias,
+	                  const HandleSet& product);
+
+	/**
+	 * Return the set of all products. The set is maintained
+	 * incrementally, only products recorded since the last call are
+	 * merged, thus the cost is linear in the number of results, and
+	 * workers are only blocked for the time of swapping their pending
+	 * products.
 	 */
-	void add_inference_record(unsigned iteration, Handle source,
-	                          const Rule& rule, const HandleSet& product);
 	HandleSet get_all_products() const;
-	HandleSet get_all_products();
+
+	/**
+	 * Return the number of distinct products so far.
+	 */
+	size_t products_size() const;
+
+	/**
+	 * Return the distinct products from the given position onward, in
+	 * the order they have been collected.
+	 */
+	HandleSeq get_products_since(size_t pos) const;
+
+	/**
+	 * Return all inference records, merged across threads and ordered
+	 * by iteration.
+	 */
+	InferenceRecordSeq get_inference_records() const;
 
 private:
-	std::vector<InferenceRecord> _inf_rec;
+	friend class ::ForwardChainerUTest;
+
+	// Append-only log of a given thread. Its mutex is only contended
+	// when the products are being collected.
+	struct ThreadLog
+	{
+		InferenceRecordSeq records;
+		HandleSeq pending_products;
+		std::mutex mutex;
+	};
+	typedef std::shared_ptr<ThreadLog> ThreadLogPtr;
+
+	// Return the log of the calling thread, create it if necessary
+	ThreadLog& thread_log();
+
+	// Merge pending products of all thread logs into _products
+	void collect_products() const;
+
+	std::unordered_map<std::thread::id, ThreadLogPtr> _thread_logs;
+	mutable std::shared_mutex _thread_logs_mutex;
+
+	// Incrementally maintained set of all products, and the same
+	// products in their order of collection.
+	mutable HandleSet _products;
+	mutable HandleSeq _products_seq;
+	mutable std::mutex _products_mutex;
+
 	AtomSpace* _trace_as;
 
-	// TODO: subdivide in smaller and shared mutexes
-	mutable std::mutex _whole_mutex;
+	TraceWriterPtr _writer;
 };
 
 }
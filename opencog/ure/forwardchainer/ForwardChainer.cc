@@ -26,8 +26,10 @@
 #include <future>
 #include <thread>
 #include <chrono>
+#include <fstream>
 
 #include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/algorithm/lower_bound.hpp>
 
 #include <opencog/util/random.h>
 #include <opencog/util/pool.h>
@@ -36,12 +38,14 @@
 #include <opencog/atoms/pattern/BindLink.h>
 #include <opencog/atoms/pattern/PatternUtils.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
 #include <opencog/ure/Rule.h>
 
 #include "ForwardChainer.h"
 #include "../URELogger.h"
 #include "../backwardchainer/ControlPolicy.h"
 #include "../ThompsonSampling.h"
+#include "../Checkpoint.h"
 
 using namespace opencog;
 
@@ -52,13 +56,29 @@ ForwardChainer::ForwardChainer(AtomSpace& kb_as,
                                const Handle& vardecl,
                                AtomSpace* trace_as,
                                const HandleSeq& focus_set)
+	: ForwardChainer(kb_as, UREConfig(rb_as, rbs), source, vardecl,
+	                 trace_as, focus_set)
+{
+}
+
+ForwardChainer::ForwardChainer(AtomSpace& kb_as,
+                               const UREConfig& config,
+                               const Handle& source,
+                               const Handle& vardecl,
+                               AtomSpace* trace_as,
+                               const HandleSeq& focus_set)
 	: _kb_as(kb_as),
-	  _rb_as(rb_as),
-	  _config(rb_as, rbs),
+	  _rb_as(config.get_atomspace()),
+	  _config(config),
 	  _thread_count(0),
 	  _sources(_config, source, vardecl),
 	  _fcstat(trace_as),
-	  _srpi(true)
+	  _budget(_config, [this]() { return _fcstat.products_size(); }),
+	  _profiler(_config.get_profile()),
+	  _srpi(true),
+	  _emitted(0),
+	  _stop_requested(false),
+	  _cancellation_token(createCancellationToken())
 {
 	init(source, vardecl, focus_set);
 }
@@ -75,6 +95,19 @@ ForwardChainer::ForwardChainer(AtomSpace& kb_as,
 {
 }
 
+ForwardChainer::ForwardChainer(std::istream& checkpoint,
+                               AtomSpace& kb_as,
+                               AtomSpace& rb_as,
+                               const Handle& rbs,
+                               const Handle& source,
+                               const Handle& vardecl,
+                               AtomSpace* trace_as,
+                               const HandleSeq& focus_set)
+	: ForwardChainer(kb_as, rb_as, rbs, source, vardecl, trace_as, focus_set)
+{
+	load_checkpoint(checkpoint);
+}
+
 ForwardChainer::~ForwardChainer()
 {
 }
@@ -85,15 +118,18 @@ void ForwardChainer::init(const Handle& source,
 {
 	validate(source);
 
-	_focus_set_as = createAtomSpace();
+	_init_source = source;
+	_init_vardecl = vardecl;
+
+	_focus_set = createFocusSet();
 	_search_focus_set = not focus_set.empty();
 
-	// Add focus set atoms and sources to focus_set atomspace
+	// Put focus set atoms and sources under focus
 	if (_search_focus_set) {
+		_focus_set_as = createAtomSpace(&_kb_as);
 		for (const Handle& h : focus_set)
-			_focus_set_as->add_atom(h);
-		for (const SourcePtr& src : _sources.sources)
-			_focus_set_as->add_atom(src->body);
+			_focus_set->insert(_focus_set_as->add_atom(h));
+		insert_sources_in_focus_set();
 	}
 
 	// Set rules.
@@ -122,6 +158,8 @@ void ForwardChainer::do_chain()
 	ure_logger().debug("Start forward chaining");
 	LAZY_URE_LOG_DEBUG << "With rule set:" << std::endl << oc_to_string(_rules);
 
+	start_budget();
+
 	// Relex2Logic uses this. TODO make a separate class to handle
 	// this robustly.
 	if(_sources.empty())
@@ -155,6 +193,18 @@ void ForwardChainer::do_chain()
 	termination_log();
 	LAZY_URE_LOG_DEBUG << "Finished forward chaining with results:"
 	                   << std::endl << oc_to_string(get_results_set());
+	LAZY_URE_LOG_DEBUG << "mk_stv memo: " << oc_to_string(mk_stv_memo_stats())
+	                   << std::endl
+	                   << "cdf memo: " << oc_to_string(cdf_memo_stats());
+	if (_profiler.is_enabled()) {
+		LAZY_URE_LOG_INFO << "Forward chaining profile:" << std::endl
+		                  << oc_to_string(_profiler);
+	}
+
+	// Write the timeline, if any is to be written
+	const TimelinePtr& timeline = _profiler.get_timeline();
+	if (timeline and not timeline->get_filename().empty())
+		timeline->write();
 }
 
 void ForwardChainer::do_steps_singlethread()
@@ -200,12 +250,32 @@ void ForwardChainer::do_steps_srpi()
 	while (not termination()) do_step_srpi(_iteration++);
 }
 
+void ForwardChainer::do_step()
+{
+	start_budget();
+	if (_srpi)
+		do_step_srpi(_iteration++);
+	else
+		do_step(_iteration++);
+}
+
+// Prefix of the log messages of the given iteration, empty if debug
+// logging is disabled as it would not be used anyway.
+static std::string iteration_msgprfx(int lipo)
+{
+	if (not URE_LOG_ENABLED(DEBUG))
+		return std::string();
+	return std::string("[I-") + std::to_string(lipo) + "] ";
+}
+
 void ForwardChainer::do_step(int iteration)
 {
 	int lipo = iteration + 1;
-	std::string msgprfx = std::string("[I-") + std::to_string(lipo) + "] ";
-	ure_logger().debug() << msgprfx << "Start iteration (" << lipo
-	                     << "/" << _config.get_maximum_iterations_str() << ")";
+	Profiler::Timer timer(_profiler, Profiler::FC_ITERATION, lipo);
+	Budget::Step budget_step(_budget);
+	std::string msgprfx = iteration_msgprfx(lipo);
+	LAZY_URE_LOG_DEBUG << msgprfx << "Start iteration (" << lipo
+	                   << "/" << _config.get_maximum_iterations_str() << ")";
 
 	// Expand meta rules. This should probably be done on-the-fly in
 	// the select_rule method, but for now it's here
@@ -226,26 +296,35 @@ void ForwardChainer::do_step(int iteration)
 	RulePtr rule = rule_prob.first;
 	double prob(rule_prob.second);
 	if (not rule->is_valid()) {
-		ure_logger().debug() << msgprfx << "No selected rule, abort iteration";
+		LAZY_URE_LOG_DEBUG << msgprfx << "No selected rule, abort iteration";
 		return;
 	} else {
 		LAZY_URE_LOG_DEBUG << msgprfx << "Selected rule, with probability " << prob
 		                   << " of success:" << std::endl << rule->to_string();
 	}
 
+	Profiler::Timer insert_timer(_profiler, Profiler::FC_SOURCE_INSERT_RULE);
 	bool success = source->insert_rule(rule);
+	insert_timer.stop();
 	if (success) {
 		// Apply rule on source
 		HandleSet products = apply_rule(*rule);
 
 		// Insert the produced sources in the population of sources
-		_sources.insert(products, *source, prob, msgprfx);
+		{
+			Profiler::Timer timer(_profiler, Profiler::FC_SOURCE_SET_INSERT);
+			_sources.insert(products, *source, prob, msgprfx);
+		}
 
 		// The rule has been applied, we can set the exhausted flag
 		source->set_rule_exhausted(rule);
 
 		// Save trace and results
-		_fcstat.add_inference_record(iteration, source->body, *rule, products);
+		{
+			Profiler::Timer timer(_profiler, Profiler::FC_STAT);
+			_fcstat.add_inference_record(iteration, source->body, rule, products);
+		}
+		emit_results();
 	} else {
 		LAZY_URE_LOG_DEBUG << msgprfx << "Rule " << rule->to_short_string()
 		                   << " is probably being applied on source "
@@ -257,9 +336,11 @@ void ForwardChainer::do_step(int iteration)
 void ForwardChainer::do_step_srpi(int iteration)
 {
 	int lipo = iteration + 1;
-	std::string msgprfx = std::string("[I-") + std::to_string(lipo) + "] ";
-	ure_logger().debug() << msgprfx << "Start iteration (" << lipo
-	                     << "/" << _config.get_maximum_iterations_str() << ")";
+	Profiler::Timer timer(_profiler, Profiler::FC_ITERATION, lipo);
+	Budget::Step budget_step(_budget);
+	std::string msgprfx = iteration_msgprfx(lipo);
+	LAZY_URE_LOG_DEBUG << msgprfx << "Start iteration (" << lipo
+	                   << "/" << _config.get_maximum_iterations_str() << ")";
 
 	// Expand meta rules. This should probably be done on-the-fly in
 	// the select_rule method, but for now it's here.
@@ -290,14 +371,21 @@ void ForwardChainer::do_step_srpi(int iteration)
 		// replaced by do_step_srpi.
 		double weight = std::min(1.0, slc_sr.source->weight);
 		double prob = success_plty / weight;
-		_sources.insert(products, *slc_sr.source, prob, msgprfx);
+		{
+			Profiler::Timer timer(_profiler, Profiler::FC_SOURCE_SET_INSERT);
+			_sources.insert(products, *slc_sr.source, prob, msgprfx);
+		}
 
 		// The rule has been applied, we can set the exhausted flag
 		slc_sr.source->set_rule_exhausted(slc_sr.rule);
 
 		// Save trace and results
-		_fcstat.add_inference_record(iteration, slc_sr.source->body,
-		                             *slc_sr.rule, products);
+		{
+			Profiler::Timer timer(_profiler, Profiler::FC_STAT);
+			_fcstat.add_inference_record(iteration, slc_sr.source->body,
+			                             slc_sr.rule, products);
+		}
+		emit_results();
 	} else {
 		LAZY_URE_LOG_DEBUG << msgprfx
 		                   << "Failed to select a source rule pair, "
@@ -309,8 +397,16 @@ bool ForwardChainer::termination()
 {
 	bool terminate = false;
 
+	// Terminate if chaining has been cancelled
+	if (_cancellation_token->is_cancelled()) {
+		terminate = true;
+	}
+	// Terminate if a result has satisfied the stop predicate
+	else if (_stop_requested) {
+		terminate = true;
+	}
 	// Terminate if all source rule pairs have been tried
-	if (_sources.is_exhausted() and _source_rule_set.empty()) {
+	else if (_sources.is_exhausted() and _source_rule_set.empty()) {
 		terminate = true;
 	}
 	// Terminate if max iterations has been reached
@@ -318,6 +414,10 @@ bool ForwardChainer::termination()
 	         _config.get_maximum_iterations() <= _iteration) {
 		terminate = true;
 	}
+	// Terminate if the time or memory budget is exhausted
+	else if (not _budget.exhausted().empty()) {
+		terminate = true;
+	}
 
 	return terminate;
 }
@@ -326,8 +426,16 @@ void ForwardChainer::termination_log()
 {
 	std::string msg;
 
+	// Terminate if chaining has been cancelled
+	if (_cancellation_token->is_cancelled()) {
+		msg = "chaining has been cancelled";
+	}
+	// Terminate if a result has satisfied the stop predicate
+	else if (_stop_requested) {
+		msg = "a result has satisfied the stop predicate";
+	}
 	// Terminate if all sources have been tried
-	if (_sources.is_exhausted() and _source_rule_set.empty()) {
+	else if (_sources.is_exhausted() and _source_rule_set.empty()) {
 		msg = "all source rule pairs have been exhausted";
 	}
 	// Terminate if max iterations has been reached
@@ -335,8 +443,12 @@ void ForwardChainer::termination_log()
 	         _config.get_maximum_iterations() <= _iteration) {
 		msg = "reach maximum number of iterations";
 	}
+	// Terminate if the time or memory budget is exhausted
+	else {
+		msg = _budget.exhausted();
+	}
 
-	ure_logger().debug() << "Terminate: " << msg;
+	LAZY_URE_LOG_DEBUG << "Terminate: " << msg;
 }
 
 /**
@@ -351,7 +463,8 @@ void ForwardChainer::apply_all_rules()
 		// Update
 		_fcstat.add_inference_record(_iteration,
 		                             _kb_as.add_node(CONCEPT_NODE, "dummy-source"),
-		                             *rule, uhs);
+		                             rule, uhs);
+		emit_results();
 	}
 }
 
@@ -367,15 +480,250 @@ HandleSet ForwardChainer::get_results_set() const
 	return _fcstat.get_all_products();
 }
 
+int ForwardChainer::get_iteration() const
+{
+	return _iteration;
+}
+
+Profiler& ForwardChainer::get_profiler()
+{
+	return _profiler;
+}
+
+const Profiler& ForwardChainer::get_profiler() const
+{
+	return _profiler;
+}
+
+void ForwardChainer::set_trace_writer(const TraceWriterPtr& writer)
+{
+	_fcstat.set_writer(writer);
+}
+
+HandleSeq ForwardChainer::get_results_since(size_t pos) const
+{
+	return _fcstat.get_products_since(pos);
+}
+
+void ForwardChainer::set_result_callback(const ResultCallback& callback)
+{
+	std::lock_guard<std::mutex> lock(_emit_mutex);
+	_result_callback = callback;
+}
+
+void ForwardChainer::set_stop_predicate(const ResultPredicate& predicate)
+{
+	std::lock_guard<std::mutex> lock(_emit_mutex);
+	_stop_predicate = predicate;
+}
+
+void ForwardChainer::cancel()
+{
+	_cancellation_token->cancel();
+}
+
+void ForwardChainer::set_cancellation_token(const CancellationTokenPtr& token)
+{
+	_cancellation_token = token;
+}
+
+const CancellationTokenPtr& ForwardChainer::get_cancellation_token() const
+{
+	return _cancellation_token;
+}
+
+void ForwardChainer::set_focus_set(const FocusSetPtr& focus_set,
+                                   const AtomSpacePtr& focus_set_as)
+{
+	_focus_set = focus_set;
+	_focus_set_as = focus_set_as;
+	_search_focus_set = true;
+	insert_sources_in_focus_set();
+}
+
+void ForwardChainer::insert_sources_in_focus_set()
+{
+	// Sources that are patterns rather than atoms of the
+	// knowledge-base have nothing to put under focus.
+	for (const SourcePtr& src : _sources.sources) {
+		Handle h = _focus_set_as->get_atom(src->body);
+		if (h)
+			_focus_set->insert(h);
+	}
+}
+
+void ForwardChainer::save_checkpoint(std::ostream& out) const
+{
+	CheckpointWriter writer(out);
+	writer.write_header('F');
+
+	// Initial source, to make sure the checkpoint is resumed by the
+	// right chainer
+	writer.write_handle(_init_source);
+	writer.write_handle(_init_vardecl);
+
+	writer.write_size(_iteration);
+
+	// Focus set, including the products obtained so far
+	writer.write_handles(_search_focus_set ? _focus_set->get_atoms()
+	                     : HandleSeq());
+
+	// Sources
+	writer.write_bool(_sources.exhausted);
+	writer.write_size(_sources.sources.size());
+	for (const SourcePtr& src : _sources.sources) {
+		writer.write_handle(src->body);
+		writer.write_handle(src->vardecl);
+		writer.write_double(src->complexity);
+		writer.write_double(src->complexity_factor);
+		writer.write_bool(src->exhausted);
+		writer.write_size(src->rules.size());
+		for (const RulePtr& rule : src->rules)
+			writer.write_rule(rule);
+	}
+
+	// Source rule set, sources are referred to by their index in the
+	// source set.
+	writer.write_size(_source_rule_set.size());
+	for (size_t i = 0; i < _source_rule_set.size(); i++) {
+		const SourceRule& sr = _source_rule_set.source_rule_seq[i];
+		auto it = boost::lower_bound(_sources.sources, sr.source,
+		                             source_ptr_less());
+		OC_ASSERT(it != _sources.sources.end());
+		writer.write_size(std::distance(_sources.sources.begin(), it));
+		writer.write_rule(sr.rule);
+		const TruthValuePtr& tv = _source_rule_set.tv_seq[i];
+		writer.write_double(tv->get_mean());
+		writer.write_double(tv->get_confidence());
+	}
+
+	// Inference records
+	InferenceRecordSeq records = _fcstat.get_inference_records();
+	writer.write_size(records.size());
+	for (const InferenceRecord& record : records) {
+		writer.write_size(record.iteration);
+		writer.write_handle(record.hsource);
+		writer.write_rule(record.rule);
+		writer.write_handles(HandleSeq(record.product.begin(),
+		                               record.product.end()));
+	}
+
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"ForwardChainer - failed to write checkpoint");
+}
+
+void ForwardChainer::save_checkpoint(const std::string& filename) const
+{
+	std::ofstream out(filename, std::ios::binary);
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"ForwardChainer - cannot open %s", filename.c_str());
+	save_checkpoint(out);
+}
+
+void ForwardChainer::load_checkpoint(std::istream& in)
+{
+	CheckpointReader reader(in);
+	reader.read_header('F');
+
+	_checkpoint_as = createAtomSpace(&_rb_as);
+
+	Handle init_source = reader.read_handle(_kb_as);
+	Handle init_vardecl = reader.read_handle(_kb_as);
+	if (not content_eq(init_source, _init_source) or
+	    not content_eq(init_vardecl, _init_vardecl))
+		throw RuntimeException(TRACE_INFO,
+			"ForwardChainer - the checkpoint does not correspond "
+			"to source %s", oc_to_string(_init_source).c_str());
+
+	_iteration = reader.read_size();
+
+	// Under focus, products live in the focus set atomspace
+	AtomSpace& products_as = _search_focus_set ? *_focus_set_as : _kb_as;
+	_focus_set->insert(reader.read_handles(products_as));
+
+	// Sources, they are saved in order, thus can be appended
+	_sources.sources.clear();
+	_sources.exhausted = reader.read_bool();
+	size_t sources_size = reader.read_size();
+	for (size_t i = 0; i < sources_size; i++) {
+		Handle body = reader.read_handle(_kb_as);
+		Handle vardecl = reader.read_handle(_kb_as);
+		double complexity = reader.read_double();
+		double complexity_factor = reader.read_double();
+		SourcePtr src = createSource(body, vardecl, complexity,
+		                             complexity_factor);
+		src->exhausted = reader.read_bool();
+		size_t rules_size = reader.read_size();
+		for (size_t j = 0; j < rules_size; j++)
+			src->insert_rule(reader.read_rule(_rb_as, *_checkpoint_as));
+		_sources.sources.push_back(src);
+	}
+
+	// Source rule set
+	size_t srs_size = reader.read_size();
+	for (size_t i = 0; i < srs_size; i++) {
+		size_t src_idx = reader.read_size();
+		if (_sources.sources.size() <= src_idx)
+			throw RuntimeException(TRACE_INFO,
+				"ForwardChainer - invalid source index %zu", src_idx);
+		RulePtr rule = reader.read_rule(_rb_as, *_checkpoint_as);
+		double mean = reader.read_double();
+		double confidence = reader.read_double();
+		_source_rule_set.insert(SourceRule(_sources.sources[src_idx], rule),
+		                        SimpleTruthValue::createTV(mean, confidence));
+	}
+
+	// Inference records
+	size_t records_size = reader.read_size();
+	for (size_t i = 0; i < records_size; i++) {
+		unsigned iteration = reader.read_size();
+		Handle hsource = reader.read_handle(_kb_as);
+		RulePtr rule = reader.read_rule(_rb_as, *_checkpoint_as);
+		HandleSeq product = reader.read_handles(products_as);
+		_fcstat.add_inference_record(iteration, hsource, rule,
+		                             HandleSet(product.begin(), product.end()));
+	}
+
+	// Results obtained before the checkpoint have already been
+	// streamed.
+	_emitted = _fcstat.products_size();
+}
+
+void ForwardChainer::emit_results()
+{
+	std::lock_guard<std::mutex> lock(_emit_mutex);
+	if (not _result_callback and not _stop_predicate)
+		return;
+
+	HandleSeq new_results = _fcstat.get_products_since(_emitted);
+	_emitted += new_results.size();
+	for (const Handle& h : new_results) {
+		if (_result_callback)
+			_result_callback(h);
+		if (_stop_predicate and _stop_predicate(h)) {
+			LAZY_URE_LOG_DEBUG << "The following result satisfies the "
+			                   << "stop predicate:" << std::endl
+			                   << oc_to_string(h);
+			_stop_requested = true;
+		}
+	}
+}
+
 SourcePtr ForwardChainer::select_source(const std::string& msgprfx)
 {
+	Profiler::Timer timer(_profiler, Profiler::FC_SELECT_SOURCE);
+
 	// TODO: refine mutex
+	Profiler::Timer wait_timer(_profiler, Profiler::FC_PART_MUTEX_WAIT);
 	std::unique_lock<std::mutex> lock(_part_mutex);
+	wait_timer.stop();
 
 	std::vector<double> weights = _sources.get_weights();
 
 	// Debug log
-	if (ure_logger().is_debug_enabled()) {
+	if (URE_LOG_ENABLED(DEBUG)) {
 		OC_ASSERT(weights.size() == _sources.size());
 		size_t wi = 0;
 		// Sort sources according to their weights
@@ -383,14 +731,14 @@ SourcePtr ForwardChainer::select_source(const std::string& msgprfx)
 		for (size_t i = 0; i < weights.size(); i++) {
 			if (0 < weights[i]) {
 				wi++;
-				if (ure_logger().is_fine_enabled()) {
+				if (URE_LOG_ENABLED(FINE)) {
 					weighted_sources.insert({weights[i], _sources.sources[i]->body});
 				}
 			}
 		}
 		LAZY_URE_LOG_DEBUG << msgprfx << "Positively weighted sources ("
 		                   << wi << "/" << weights.size() << ")";
-		if (ure_logger().is_fine_enabled()) {
+		if (URE_LOG_ENABLED(FINE)) {
 			std::stringstream ws_ss;
 			for (const auto& wsp : boost::adaptors::reverse(weighted_sources))
 				ws_ss << std::endl << wsp.first << " " << wsp.second->id_to_string();
@@ -402,16 +750,17 @@ SourcePtr ForwardChainer::select_source(const std::string& msgprfx)
 	double total = boost::accumulate(weights, 0.0);
 
 	if (total == 0.0) {
-		ure_logger().debug() << msgprfx << "All sources have been exhausted";
+		LAZY_URE_LOG_DEBUG << msgprfx << "All sources have been exhausted";
 		if (_config.get_retry_exhausted_sources()) {
-			ure_logger().debug() << msgprfx
-			                     << "Reset all exhausted flags to retry them";
+			LAZY_URE_LOG_DEBUG << msgprfx
+			                   << "Reset all exhausted flags to retry them";
 			// TODO: This has the effect of deallocating the rules, which
 			// might cause a memory corruption if another thread is
 			// attempting to apply that rule at the same time.
 			_sources.reset_exhausted();
 			// Try again
 			lock.unlock();
+			timer.stop();
 			return select_source(msgprfx);
 		} else {
 			_sources.set_exhausted();
@@ -438,7 +787,7 @@ SourceRule ForwardChainer::mk_source_rule(const std::string& msgprfx)
 	const RuleSet valid_rules = get_valid_rules(*source);
 
 	// Log valid rules
-	if (ure_logger().is_debug_enabled()) {
+	if (URE_LOG_ENABLED(DEBUG)) {
 		std::stringstream ss;
 		if (valid_rules.empty())
 			ss << msgprfx << "No valid rule for that source. Let's try again";
@@ -457,7 +806,9 @@ SourceRule ForwardChainer::mk_source_rule(const std::string& msgprfx)
 	// Thompson sample according to rule tvs
 	TruthValueSeq tvs = valid_rules.get_tvs();
 	RulePtr slc_rule = valid_rules[ThompsonSampling(tvs)()];
+	Profiler::Timer insert_timer(_profiler, Profiler::FC_SOURCE_INSERT_RULE);
 	bool success = source->insert_rule(slc_rule);
+	insert_timer.stop();
 	if (not success)
 		return SourceRule();
 	source->set_rule_exhausted(slc_rule);
@@ -520,7 +871,10 @@ TruthValuePtr ForwardChainer::calculate_source_rule_tv(const SourceRule& sr)
 
 RuleSet ForwardChainer::get_valid_rules(const Source& source)
 {
+	Profiler::Timer timer(_profiler, Profiler::FC_GET_VALID_RULES);
+	Profiler::Timer wait_timer(_profiler, Profiler::FC_RULES_MUTEX_WAIT);
 	std::lock_guard<std::mutex> lock(_rules_mutex); // TODO: refine
+	wait_timer.stop();
 
 	// Generate all valid rules
 	RuleSet valid_rules;
@@ -530,9 +884,13 @@ RuleSet ForwardChainer::get_valid_rules(const Source& source)
 		if (rule->is_meta())
 			continue;
 
-		const AtomSpace& ref_as(_search_focus_set ? *_focus_set_as.get() : _kb_as);
+		// Constant clauses are only removed if known to hold,
+		// which, under focus, is left to rule application.
+		Profiler::Timer unify_timer(_profiler, Profiler::FC_UNIFICATION);
 		RuleTypedSubstitutionMap urm =
-			rule->unify_source(source.body, source.vardecl, &ref_as);
+			rule->unify_source(source.body, source.vardecl,
+			                   _search_focus_set ? nullptr : &_kb_as);
+		unify_timer.stop();
 		RuleSet unified_rules = Rule::strip_typed_substitution(urm);
 
 		// Only insert unexhausted rules for this source
@@ -571,7 +929,7 @@ RuleProbabilityPair ForwardChainer::select_rule(Source& source,
 	const RuleSet valid_rules = get_valid_rules(source);
 
 	// Log valid rules
-	if (ure_logger().is_debug_enabled()) {
+	if (URE_LOG_ENABLED(DEBUG)) {
 		std::stringstream ss;
 		if (valid_rules.empty())
 			ss << msgprfx << "No valid rule";
@@ -599,7 +957,7 @@ RuleProbabilityPair ForwardChainer::select_rule(const RuleSet& valid_rules,
 	std::vector<double> weights = ThompsonSampling(tvs).distribution();
 
 	// Log the distribution
-	if (ure_logger().is_debug_enabled()) {
+	if (URE_LOG_ENABLED(DEBUG)) {
 		std::stringstream ss;
 		ss << msgprfx << "Rule weights:";
 		size_t i = 0;
@@ -607,7 +965,7 @@ RuleProbabilityPair ForwardChainer::select_rule(const RuleSet& valid_rules,
 			ss << std::endl << weights[i] << " " << rule->get_name();
 			i++;
 		}
-		ure_logger().debug() << ss.str();
+		LAZY_URE_LOG_DEBUG << ss.str();
 	}
 
 	// Sample rules according to the weights
@@ -623,8 +981,13 @@ RuleProbabilityPair ForwardChainer::select_rule(const RuleSet& valid_rules,
 
 HandleSet ForwardChainer::apply_rule(const Rule& rule)
 {
+	Profiler::Timer timer(_profiler, Profiler::FC_APPLY_RULE);
 	HandleSet results;
 
+	// Do not start applying a rule if chaining has been cancelled
+	if (_cancellation_token->is_cancelled())
+		return results;
+
 	// Take the results from applying the rule, add them in the given
 	// AtomSpace and insert them in results
 	auto add_results = [&](AtomSpace& as, const HandleSeq& hs) {
@@ -647,8 +1010,17 @@ HandleSet ForwardChainer::apply_rule(const Rule& rule)
 	// Wrap in try/catch in case the pattern matcher can't handle it
 	try
 	{
-		AtomSpace& ref_as(_search_focus_set ? *_focus_set_as.get() : _kb_as);
-		AtomSpacePtr derived_rule_as(createAtomSpace(&ref_as));
+		// Only apply the rule on premises under focus, and put its
+		// products under focus. They are added to the focus set
+		// atomspace, leaving the knowledge-base untouched.
+		if (_search_focus_set) {
+			add_results(*_focus_set_as,
+			            _focus_set->execute(rule.get_rule(), *_focus_set_as));
+			_focus_set->insert(results);
+			return results;
+		}
+
+		AtomSpacePtr derived_rule_as(createAtomSpace(&_kb_as));
 		derived_rule_as->clear_copy_on_write(); // _as should be write-through.
 		Handle rhcpy = derived_rule_as->add_atom(rule.get_rule());
 
@@ -658,11 +1030,11 @@ HandleSet ForwardChainer::apply_rule(const Rule& rule)
 		const HandleSet& varset = rule.get_variables().varset;
 		for (Handle clause : clauses)
 			if (is_constant(varset, clause))
-				if (ref_as.get_atom(clause) == Handle::UNDEFINED)
+				if (_kb_as.get_atom(clause) == Handle::UNDEFINED)
 					return results;
 
-		Handle h = HandleCast(rhcpy->execute(&ref_as));
-		add_results(ref_as, h->getOutgoingSet());
+		Handle h = HandleCast(rhcpy->execute(&_kb_as));
+		add_results(_kb_as, h->getOutgoingSet());
 	}
 	catch (...) {}
 
@@ -674,6 +1046,11 @@ HandleSet ForwardChainer::apply_rule(const SourceRule& sr)
 	return apply_rule(*sr.rule);
 }
 
+void ForwardChainer::start_budget()
+{
+	_budget.start();
+}
+
 void ForwardChainer::validate(const Handle& source)
 {
 	if (source == Handle::UNDEFINED)
@@ -682,14 +1059,16 @@ void ForwardChainer::validate(const Handle& source)
 
 void ForwardChainer::expand_meta_rules(const std::string& msgprfx)
 {
+	Profiler::Timer wait_timer(_profiler, Profiler::FC_RULES_MUTEX_WAIT);
 	std::lock_guard<std::mutex> lock(_rules_mutex);
+	wait_timer.stop();
 	// This is kinda of hack before meta rules are fully supported by
 	// the Rule class.
 	size_t rules_size = _rules.size();
 	_rules.expand_meta_rules(_kb_as);
 
 	if (rules_size != _rules.size()) {
-		ure_logger().debug() << msgprfx << "The rule set has gone from "
-		                     << rules_size << " to " << _rules.size() << " rules";
+		LAZY_URE_LOG_DEBUG << msgprfx << "The rule set has gone from "
+		                   << rules_size << " to " << _rules.size() << " rules";
 	}
 }
@@ -24,10 +24,17 @@
 #ifndef _OPENCOG_FORWARDCHAINER_H_
 #define _OPENCOG_FORWARDCHAINER_H_
 
+#include <istream>
 #include <mutex>
+#include <ostream>
 // #include <shared_mutex>
 
 #include "../UREConfig.h"
+#include "../Budget.h"
+#include "../CancellationToken.h"
+#include "../FocusSet.h"
+#include "../Utils.h"
+#include "../Profiler.h"
 #include "SourceSet.h"
 #include "SourceRuleSet.h"
 #include "FCStat.h"
@@ -60,7 +67,9 @@ public:
 	 * @param source    Source to start with, if it is a pattern, or a Set,
 	 *                  multiple sources are considered
 	 * @param vardecl   Variable declaration of Source if pattern
-	 * @param focus_set Set of atoms under focus
+	 * @param focus_set Set of atoms under focus. The products are
+	 *                  then held in a child atomspace of kb_as,
+	 *                  leaving kb_as untouched till get_results.
 	 */
 	ForwardChainer(AtomSpace& kb_as,
 	               AtomSpace& rb_as,
@@ -70,6 +79,18 @@ public:
 	               AtomSpace* trace_as=nullptr,
 	               const HandleSeq& focus_set=HandleSeq());
 
+	/**
+	 * Like above, but use an already loaded configuration, copied so
+	 * that modifying it does not affect the given one. Avoids
+	 * querying the rule-base atomspace for each chainer.
+	 */
+	ForwardChainer(AtomSpace& kb_as,
+	               const UREConfig& config,
+	               const Handle& source,
+	               const Handle& vardecl=Handle::UNDEFINED,
+	               AtomSpace* trace_as=nullptr,
+	               const HandleSeq& focus_set=HandleSeq());
+
 	/**
 	 * Like above, but use as rule-base atomspace, the atomspace of rbs
 	 * if any, otherwise use kb_as if rbs has no atomspace.
@@ -80,6 +101,23 @@ public:
 	               const Handle& vardecl=Handle::UNDEFINED,
 	               AtomSpace* trace_as=nullptr,
 	               const HandleSeq& focus_set=HandleSeq());
+	/**
+	 * Resume a forward chainer from a checkpoint previously saved by
+	 * save_checkpoint. The remaining arguments must be the same as the
+	 * ones of the chainer that has been saved, and the knowledge-base
+	 * must contain, at least, what it did at the time it was saved.
+	 *
+	 * Throw a RuntimeException if the checkpoint is invalid or does
+	 * not correspond to the given source.
+	 */
+	ForwardChainer(std::istream& checkpoint,
+	               AtomSpace& kb_as,
+	               AtomSpace& rb_as,
+	               const Handle& rbs,
+	               const Handle& source,
+	               const Handle& vardecl=Handle::UNDEFINED,
+	               AtomSpace* trace_as=nullptr,
+	               const HandleSeq& focus_set=HandleSeq());
 	~ForwardChainer();
 
 	/**
@@ -117,6 +155,13 @@ public:
 	 */
 	void do_step_srpi(int iteration);
 
+	/**
+	 * Perform the next forward chaining inference step. Meant to
+	 * drive the chainer step by step, while consuming its results with
+	 * get_results_since.
+	 */
+	void do_step();
+
 	/**
 	 * @return true if the termination criteria have been met.
 	 */
@@ -133,6 +178,86 @@ public:
 	Handle get_results() const;
 	HandleSet get_results_set() const;
 
+	/**
+	 * @return the results from position pos onward, in their order of
+	 * production. Starting at 0 and advancing pos by the size of the
+	 * returned sequence allows to consume results as they come.
+	 */
+	HandleSeq get_results_since(size_t pos) const;
+
+	/**
+	 * @return the number of iterations performed so far.
+	 */
+	int get_iteration() const;
+
+	/**
+	 * Profiler counting and timing the phases of the chainer. It is
+	 * enabled by the URE:profile parameter, or can be enabled here
+	 * before chaining. Statistics remain available after chaining.
+	 *
+	 * A timeline can be attached to it as well, to record the
+	 * iterations and phases per thread. If the timeline has a
+	 * filename, it is written at the end of do_chain.
+	 */
+	Profiler& get_profiler();
+	const Profiler& get_profiler() const;
+
+	/**
+	 * Record the inference steps in the given trace file as well, or
+	 * stop doing so if nullptr. The file is not closed at the end of
+	 * chaining, so that the traces of several chainings can be
+	 * appended to it.
+	 */
+	void set_trace_writer(const TraceWriterPtr& writer);
+
+	/**
+	 * Set a callback to be called on each new result as soon as it is
+	 * produced. Calls are serialized, even when multiple jobs are
+	 * running.
+	 */
+	void set_result_callback(const ResultCallback& callback);
+
+	/**
+	 * Set a predicate to stop chaining as soon as a new result
+	 * satisfies it. Results produced so far remain available.
+	 */
+	void set_stop_predicate(const ResultPredicate& predicate);
+
+	/**
+	 * Cancel chaining, can be called from any thread. Chaining stops
+	 * at the next step, or before the next rule application, results
+	 * obtained so far remain available.
+	 */
+	void cancel();
+
+	/**
+	 * Set and get the cancellation token. Setting a token, before
+	 * chaining, allows to share it between several chainers, so that
+	 * one call cancels them all.
+	 */
+	void set_cancellation_token(const CancellationTokenPtr& token);
+	const CancellationTokenPtr& get_cancellation_token() const;
+
+	/**
+	 * Restrict chaining to the given focus set, instead of its own,
+	 * with focus_set_as, a child of the knowledge-base atomspace,
+	 * holding the atoms produced under focus. Allows several chainers
+	 * to share the same focus set, as well as the atoms they
+	 * produce. The sources are added to it. Must be called before
+	 * chaining.
+	 */
+	void set_focus_set(const FocusSetPtr& focus_set,
+	                   const AtomSpacePtr& focus_set_as);
+
+	/**
+	 * Save the state of the chainer, that is its sources, its source
+	 * rule set, its inference records and its iteration count, so
+	 * that chaining can be resumed later on with the checkpoint
+	 * constructor above. Must not be called while chaining.
+	 */
+	void save_checkpoint(std::ostream& out) const;
+	void save_checkpoint(const std::string& filename) const;
+
 private:
 	friend class ::ForwardChainerUTest;
 
@@ -142,8 +267,29 @@ private:
 
 	void apply_all_rules();
 
+	/**
+	 * Restore the state saved by save_checkpoint.
+	 */
+	void load_checkpoint(std::istream& in);
+
 	void validate(const Handle& source);
 
+	/**
+	 * Put the sources present in the knowledge-base under focus.
+	 */
+	void insert_sources_in_focus_set();
+
+	/**
+	 * Start keeping track of the resources consumed, if not already.
+	 */
+	void start_budget();
+
+	/**
+	 * Pass the results produced since the last call to the result
+	 * callback and the stop predicate, if any.
+	 */
+	void emit_results();
+
 	/**
 	 * Expand all meta rules into mesa rules.
 	 *
@@ -220,11 +366,22 @@ private:
 	// Rule base atomspace (can be the same as _kb_as)
 	AtomSpace& _rb_as;
 
-	// The focus set is copied into this atomspace; during chaining,
-	// the pattern matcher is applied only to this atomspace.  This
-	// is the primary mechanism by which chaining is restricted to
-	// the focus set.  This is effective, but not very efficient;
-	// perhaps there is some better mechanism?
+	// Hold the rule specializations restored from a checkpoint, so
+	// that they do not pollute the rule base atomspace.
+	AtomSpacePtr _checkpoint_as;
+
+	// Initial source and its variable declaration, to check that a
+	// checkpoint corresponds to that chainer.
+	Handle _init_source;
+	Handle _init_vardecl;
+
+	// Atoms of _focus_set_as under focus, including sources and
+	// products. Rules are only applied on premises under focus.
+	FocusSetPtr _focus_set;
+
+	// Child of _kb_as holding the atoms under focus missing from
+	// _kb_as, and the products, so that focused chaining does not
+	// alter the knowledge-base.
 	AtomSpacePtr _focus_set_as;
 
 	UREConfig _config;
@@ -249,15 +406,35 @@ private:
 
 	FCStat _fcstat;
 
+	// Keep track of the time and memory consumed
+	Budget _budget;
+
+	// Count and time the phases of chaining
+	Profiler _profiler;
+
 	// Enable alternative implementation using (source, rule) producer,
 	// srpi stands for Source Rule Producer Implementation. This flag
 	// is here, likely temporarily, to compare old and new way.
-	const bool _srpi;
+	bool _srpi;
 
 	// Set of weighted pairs (source, rule).
 	SourceRuleSet _source_rule_set;
+
+	// Streaming of results
+	ResultCallback _result_callback;
+	ResultPredicate _stop_predicate;
+	size_t _emitted;
+	std::mutex _emit_mutex;
+
+	// Set when a result has satisfied the stop predicate
+	std::atomic<bool> _stop_requested;
+
+	// Set to cancel chaining
+	CancellationTokenPtr _cancellation_token;
 };
 
+typedef std::shared_ptr<ForwardChainer> ForwardChainerPtr;
+
 } // ~namespace opencog
 
 #endif /* _OPENCOG_FORWARDCHAINER_H_ */
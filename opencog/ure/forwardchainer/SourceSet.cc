@@ -240,7 +240,7 @@ void SourceSet::insert(const HandleSet& products, const Source& src,
 	}
 
 	// Log the new sources
-	if (ure_logger().is_debug_enabled()) {
+	if (URE_LOG_ENABLED(DEBUG)) {
 		LAZY_URE_LOG_DEBUG << msgprfx
 		                   << products.size() << " results, including "
 		                   << new_srcs.size() << " new sources";
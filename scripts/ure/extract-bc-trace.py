@@ -2,6 +2,9 @@
 
 # Given a log file, and a FCS handle, filtered that log file to retain
 # only the iterations leading to that FCS.
+#
+# Note that traces can be recorded directly, without parsing logs, with
+# the #:trace-file option of cog-bc, see cog-ure-load-trace.
 
 import sys
 import re
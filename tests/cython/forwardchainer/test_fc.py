@@ -62,6 +62,52 @@ class FCTest(TestCase):
         self.assertAlmostEqual(1.0, resultTV.mean, places=5)
         self.assertAlmostEqual(1.0, resultTV.confidence, places=5)
 
+    def test_fc_deduction_stream(self):
+        self.init()
+        scheme_eval(self.atomspace, '(load-from-path "fc-deduction-config.scm")')
+
+        A = ConceptNode("A")
+        B = ConceptNode("B")
+        C = ConceptNode("C")
+
+        InheritanceLink(A, B).tv = TruthValue(0.8, 0.9)
+        InheritanceLink(B, C).tv = TruthValue(0.98, 0.94)
+
+        chainer = ForwardChainer(self.atomspace,
+                                 ConceptNode("fc-deduction-rule-base"),
+                                 InheritanceLink(VariableNode("$who"), C),
+                                 TypedVariableLink(VariableNode("$who"), TypeNode("ConceptNode")))
+        streamed = []
+        for result in chainer.stream():
+            streamed.append(result)
+            if result == InheritanceLink(A, C):
+                break
+
+        self.assertIn(InheritanceLink(A, C), streamed)
+        self.assertEqual(set(streamed), set(chainer.get_results().out))
+
+    def test_fc_deduction_profile(self):
+        self.init()
+        scheme_eval(self.atomspace, '(load-from-path "fc-deduction-config.scm")')
+
+        InheritanceLink(ConceptNode("A"), ConceptNode("B")).tv = TruthValue(0.8, 0.9)
+        InheritanceLink(ConceptNode("B"), ConceptNode("C")).tv = TruthValue(0.98, 0.94)
+
+        chainer = ForwardChainer(self.atomspace,
+                                 ConceptNode("fc-deduction-rule-base"),
+                                 InheritanceLink(VariableNode("$who"), ConceptNode("C")),
+                                 TypedVariableLink(VariableNode("$who"), TypeNode("ConceptNode")))
+        self.assertEqual({}, chainer.get_profile())
+        chainer.enable_profiling()
+        chainer.do_chain()
+        profile = chainer.get_profile()
+
+        self.assertIn("apply_rule", profile)
+        apply_rule = profile["apply_rule"]
+        self.assertLess(0, apply_rule["count"])
+        self.assertEqual(apply_rule["count"], sum(apply_rule["histogram"]))
+        self.assertLessEqual(apply_rule["min_ns"], apply_rule["max_ns"])
+
 
 if __name__ == '__main__':
     os.environ["PROJECT_SOURCE_DIR"] = "../../.."